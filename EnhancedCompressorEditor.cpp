@@ -65,6 +65,16 @@ EnhancedCompressorEditor::EnhancedCompressorEditor(UniversalCompressor& p)
     currentMode = modeParam ? static_cast<int>(*modeParam) : 0;
     updateMode(currentMode);
     
+    // CPU overlay, hidden until the title is double-clicked
+    cpuOverlay = std::make_unique<juce::Label>("CPU", juce::String());
+    cpuOverlay->setJustificationType(juce::Justification::centredRight);
+    cpuOverlay->setColour(juce::Label::textColourId, juce::Colours::white.withAlpha(0.7f));
+    cpuOverlay->setInterceptsMouseClicks(false, false);
+    addChildComponent(cpuOverlay.get());
+    
+    // Frames queued while no editor was open are stale - start the history from now
+    while (processor.readMeterHistory(meterFrames.data(), static_cast<int>(meterFrames.size())) > 0) {}
+    
     // Start timer for meter updates
     startTimerHz(30);
     
@@ -86,6 +96,7 @@ EnhancedCompressorEditor::EnhancedCompressorEditor(UniversalCompressor& p)
 EnhancedCompressorEditor::~EnhancedCompressorEditor()
 {
     processor.getParameters().removeParameterListener("mode", this);
+    setCpuOverlayVisible(false);
     setLookAndFeel(nullptr);
 }
 
@@ -589,6 +600,14 @@ void EnhancedCompressorEditor::resized()
     if (resizer)
         resizer->setBounds(getWidth() - 16, getHeight() - 16, 16, 16);
     
+    // CPU overlay in the empty space right of the title
+    if (cpuOverlay)
+    {
+        cpuOverlay->setFont(juce::Font(juce::FontOptions(10.0f * scaleFactor)));
+        cpuOverlay->setBounds(getWidth() - static_cast<int>(210 * scaleFactor), static_cast<int>(8 * scaleFactor),
+                              static_cast<int>(200 * scaleFactor), static_cast<int>(20 * scaleFactor));
+    }
+    
     // Top row - mode selector and global controls (scale all values)
     // Leave space for title
     auto topRow = bounds.removeFromTop(70 * scaleFactor).withTrimmedTop(35 * scaleFactor);
@@ -824,14 +843,78 @@ void EnhancedCompressorEditor::resized()
 void EnhancedCompressorEditor::timerCallback()
 {
     updateMeters();
+    
+    if (cpuOverlay && cpuOverlay->isVisible() && ++cpuOverlayTicks >= 15)
+    {
+        cpuOverlayTicks = 0;
+        updateCpuOverlay();
+    }
+}
+
+void EnhancedCompressorEditor::mouseDoubleClick(const juce::MouseEvent& event)
+{
+    // The title strip toggles the CPU overlay
+    if (cpuOverlay && event.y < 35 * scaleFactor)
+        setCpuOverlayVisible(!cpuOverlay->isVisible());
+}
+
+void EnhancedCompressorEditor::setCpuOverlayVisible(bool shouldBeVisible)
+{
+    if (!cpuOverlay || cpuOverlay->isVisible() == shouldBeVisible)
+        return;
+    
+    // Timing only runs while someone is looking at it
+    processor.setCpuTimingEnabled(shouldBeVisible);
+    processor.resetCpuStatistics();
+    cpuOverlayTicks = 0;
+    cpuOverlay->setText("CPU --", juce::dontSendNotification);
+    cpuOverlay->setVisible(shouldBeVisible);
+}
+
+void EnhancedCompressorEditor::updateCpuOverlay()
+{
+    // Load is a share of each block's duration - 100% would miss the audio deadline
+    const auto statistics = processor.getCpuStatistics();
+    processor.resetCpuStatistics();
+    
+    if (statistics.numBlocks == 0)
+    {
+        cpuOverlay->setText("CPU --", juce::dontSendNotification);
+        return;
+    }
+    
+    cpuOverlay->setText("CPU " + juce::String(statistics.meanLoadPercent, 1) + "% avg  "
+                        + juce::String(statistics.p99LoadPercent, 1) + "% p99  "
+                        + juce::String(statistics.maxLoadPercent, 1) + "% max",
+                        juce::dontSendNotification);
 }
 
 void EnhancedCompressorEditor::updateMeters()
 {
+    // Drain every block the audio thread metered since the last tick, so peaks and
+    // gain reduction transients between polls are not lost. Without new frames
+    // (transport stopped) the latest values are read as before
+    float inputDb = processor.getInputLevel();
+    float outputDb = processor.getOutputLevel();
+    float gainReduction = processor.getGainReduction();
+    
+    const int numFrames = processor.readMeterHistory(meterFrames.data(), static_cast<int>(meterFrames.size()));
+    if (numFrames > 0)
+    {
+        inputDb = outputDb = -60.0f;
+        gainReduction = 0.0f;
+        for (int i = 0; i < numFrames; ++i)
+        {
+            const auto& frame = meterFrames[static_cast<size_t>(i)];
+            inputDb = juce::jmax(inputDb, frame.inputDb);
+            outputDb = juce::jmax(outputDb, frame.outputDb);
+            gainReduction = juce::jmin(gainReduction, frame.minGainReductionDb);
+        }
+    }
+    
     if (inputMeter)
     {
         // LEDMeter expects dB values, not linear
-        float inputDb = processor.getInputLevel();
         inputMeter->setLevel(inputDb);
         
         // Apply smoothing to the readout value for better readability
@@ -850,12 +933,11 @@ void EnhancedCompressorEditor::updateMeters()
     }
     
     if (vuMeter)
-        vuMeter->setLevel(processor.getGainReduction());
+        vuMeter->setLevel(gainReduction);
     
     if (outputMeter)
     {
         // LEDMeter expects dB values, not linear
-        float outputDb = processor.getOutputLevel();
         outputMeter->setLevel(outputDb);
         
         // Apply smoothing to the readout value for better readability
@@ -24,6 +24,7 @@ public:
     void parameterChanged(const juce::String& parameterID, float newValue) override;
     void comboBoxChanged(juce::ComboBox* comboBoxThatHasChanged) override;
     void ratioChanged(int ratioIndex) override;
+    void mouseDoubleClick(const juce::MouseEvent& event) override;
 
 private:
     // Processor reference
@@ -156,6 +157,14 @@ private:
     float smoothedOutputLevel = -60.0f;
     const float levelSmoothingFactor = 0.985f;  // Very high smoothing (0.985 = ~1 second at 30Hz)
     
+    // CPU load overlay, toggled by double-clicking the title. While it is shown the
+    // processor times every block and the overlay shows the last half second
+    std::unique_ptr<juce::Label> cpuOverlay;
+    int cpuOverlayTicks = 0;
+    
+    // Scratch for draining the processor's meter history on each timer tick
+    std::array<UniversalCompressor::MeterFrame, UniversalCompressor::METER_HISTORY_SIZE> meterFrames;
+    
     // Helper methods
     void setupOptoPanel();
     void setupFETPanel();
@@ -164,6 +173,8 @@ private:
     
     void updateMode(int newMode);
     void updateMeters();
+    void setCpuOverlayVisible(bool shouldBeVisible);
+    void updateCpuOverlay();
     void createBackgroundTexture();
     
     juce::Slider* createKnob(const juce::String& name, float min, float max, 
@@ -0,0 +1,365 @@
+#include "RealtimeSafetyCheck.h"
+
+#if UNIVERSAL_COMPRESSOR_RT_SAFETY_CHECK
+#include <atomic>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include <time.h>
+#include <unistd.h>
+
+// glibc's own allocator, which the interposed malloc family forwards to
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void __libc_free(void*);
+}
+#endif
+
+namespace RealtimeSafetyCheck
+{
+    namespace
+    {
+        constexpr int MAX_VIOLATIONS = 256;
+        constexpr int MAX_FRAMES = 32;
+        
+        struct Violation
+        {
+            const char* call;
+            int numFrames;
+            void* frames[MAX_FRAMES];
+        };
+        
+        // Initial-exec TLS, so reading the flag from inside malloc never allocates
+        #if defined(__GNUC__)
+            #define UNIVERSAL_COMPRESSOR_TLS_MODEL __attribute__((tls_model("initial-exec")))
+        #else
+            #define UNIVERSAL_COMPRESSOR_TLS_MODEL
+        #endif
+        
+        thread_local int activeChecks UNIVERSAL_COMPRESSOR_TLS_MODEL = 0;       // Checks of the audio callback, 0 outside it
+        thread_local bool recording UNIVERSAL_COMPRESSOR_TLS_MODEL = false;  // The recorder's own calls pass
+        
+        Violation violations[MAX_VIOLATIONS];
+        std::atomic<int> numViolations { 0 };
+        
+        // Fixed storage only - this runs inside the offending call
+        void record(const char* call, Checks kind) noexcept
+        {
+            if ((activeChecks & kind) == 0 || recording)
+                return;
+            
+            recording = true;
+            const int index = numViolations.fetch_add(1, std::memory_order_relaxed);
+            if (index < MAX_VIOLATIONS)
+            {
+                auto& violation = violations[index];
+                violation.call = call;
+                #if defined(__GLIBC__)
+                    violation.numFrames = backtrace(violation.frames, MAX_FRAMES);
+                #else
+                    violation.numFrames = 0;
+                #endif
+            }
+            
+            // Still recording, so whatever the assertion handler allocates passes
+            #if UNIVERSAL_COMPRESSOR_RT_SAFETY_ASSERT
+                jassertfalse; // Not real-time safe - move this out of processBlock, see the call stack
+            #endif
+            recording = false;
+        }
+        
+        #if defined(__GLIBC__)
+        // The first backtrace loads the unwinder, which allocates. Do that at startup
+        const int unwinderLoaded = []
+        {
+            void* frame = nullptr;
+            return backtrace(&frame, 1);
+        }();
+        
+        // Next definition of an interposed function, looked up on first use
+        template <typename Function>
+        Function next(std::atomic<void*>& slot, const char* name) noexcept
+        {
+            void* function = slot.load(std::memory_order_acquire);
+            if (function == nullptr)
+            {
+                const bool wasRecording = recording;
+                recording = true;
+                function = dlsym(RTLD_NEXT, name);
+                recording = wasRecording;
+                slot.store(function, std::memory_order_release);
+            }
+            return reinterpret_cast<Function>(function);
+        }
+        
+        juce::String symbolise(void* frame, const char* symbol)
+        {
+            // glibc gives "binary(mangled+offset) [address]"
+            juce::String text(symbol);
+            const auto mangled = text.fromFirstOccurrenceOf("(", false, false).upToFirstOccurrenceOf("+", false, false);
+            if (mangled.isNotEmpty())
+            {
+                int status = 0;
+                if (char* demangled = abi::__cxa_demangle(mangled.toRawUTF8(), nullptr, nullptr, &status))
+                {
+                    text = juce::String(demangled);
+                    std::free(demangled);
+                }
+            }
+            return text.isNotEmpty() ? text : juce::String::toHexString(reinterpret_cast<juce::pointer_sized_int>(frame));
+        }
+        #endif
+    }
+    
+    ScopedAudioCallback::ScopedAudioCallback(int checks) noexcept : previous(activeChecks)
+    {
+        activeChecks = checks;
+    }
+    
+    ScopedAudioCallback::~ScopedAudioCallback() noexcept
+    {
+        activeChecks = previous;
+    }
+    
+    int getNumViolations() noexcept
+    {
+        return numViolations.load(std::memory_order_relaxed);
+    }
+    
+    void reset() noexcept
+    {
+        numViolations.store(0, std::memory_order_relaxed);
+    }
+    
+    juce::String describeViolations()
+    {
+        const int total = getNumViolations();
+        const int numRecorded = juce::jmin(total, MAX_VIOLATIONS);
+        
+        // Merge identical call stacks, keeping the first occurrence's order
+        juce::Array<int> firstIndices, counts;
+        for (int i = 0; i < numRecorded; ++i)
+        {
+            const auto& violation = violations[i];
+            int match = -1;
+            for (int j = 0; j < firstIndices.size() && match < 0; ++j)
+            {
+                const auto& other = violations[firstIndices[j]];
+                if (other.call == violation.call && other.numFrames == violation.numFrames
+                    && std::equal(violation.frames, violation.frames + violation.numFrames, other.frames))
+                    match = j;
+            }
+            
+            if (match < 0)
+            {
+                firstIndices.add(i);
+                counts.add(1);
+            }
+            else
+            {
+                counts.set(match, counts[match] + 1);
+            }
+        }
+        
+        juce::String text;
+        text << total << " real-time safety violation(s)";
+        if (total > numRecorded)
+            text << ", the first " << numRecorded << " recorded";
+        text << juce::newLine;
+        
+        for (int j = 0; j < firstIndices.size(); ++j)
+        {
+            const auto& violation = violations[firstIndices[j]];
+            text << juce::newLine << violation.call << " inside the audio callback (" << counts[j] << "x)" << juce::newLine;
+            
+            #if defined(__GLIBC__)
+                // Frame 0 is the recorder itself
+                if (char** symbols = backtrace_symbols(violation.frames, violation.numFrames))
+                {
+                    for (int frame = 1; frame < violation.numFrames; ++frame)
+                        text << "    " << symbolise(violation.frames[frame], symbols[frame]) << juce::newLine;
+                    std::free(symbols);
+                }
+            #endif
+        }
+        return text;
+    }
+}
+
+//==============================================================================
+#if defined(__GLIBC__)
+// Interposed libc entry points. Each records the call when made inside the audio
+// callback, then forwards to glibc
+namespace
+{
+    std::atomic<void*> nextMutexLock, nextRwlockRead, nextRwlockWrite, nextCondWait, nextCondTimedWait, nextSemWait;
+    std::atomic<void*> nextOpen, nextClose, nextRead, nextWrite, nextNanosleep, nextClockNanosleep, nextUsleep;
+}
+
+using RealtimeSafetyCheck::record;
+
+extern "C"
+{
+    void* malloc(size_t size) noexcept { record("malloc", RealtimeSafetyCheck::heap); return __libc_malloc(size); }
+    void* calloc(size_t count, size_t size) noexcept { record("calloc", RealtimeSafetyCheck::heap); return __libc_calloc(count, size); }
+    void* realloc(void* ptr, size_t size) noexcept { record("realloc", RealtimeSafetyCheck::heap); return __libc_realloc(ptr, size); }
+    void* aligned_alloc(size_t alignment, size_t size) noexcept { record("aligned_alloc", RealtimeSafetyCheck::heap); return __libc_memalign(alignment, size); }
+    void* memalign(size_t alignment, size_t size) noexcept { record("memalign", RealtimeSafetyCheck::heap); return __libc_memalign(alignment, size); }
+    
+    void free(void* ptr) noexcept
+    {
+        if (ptr != nullptr)
+            record("free", RealtimeSafetyCheck::heap);
+        __libc_free(ptr);
+    }
+    
+    int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+    {
+        record("posix_memalign", RealtimeSafetyCheck::heap);
+        if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0)
+            return EINVAL;
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr ? 0 : ENOMEM;
+    }
+    
+    int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+    {
+        record("pthread_mutex_lock", RealtimeSafetyCheck::locks);
+        return RealtimeSafetyCheck::next<int (*)(pthread_mutex_t*)>(nextMutexLock, "pthread_mutex_lock")(mutex);
+    }
+    
+    int pthread_rwlock_rdlock(pthread_rwlock_t* lock) noexcept
+    {
+        record("pthread_rwlock_rdlock", RealtimeSafetyCheck::locks);
+        return RealtimeSafetyCheck::next<int (*)(pthread_rwlock_t*)>(nextRwlockRead, "pthread_rwlock_rdlock")(lock);
+    }
+    
+    int pthread_rwlock_wrlock(pthread_rwlock_t* lock) noexcept
+    {
+        record("pthread_rwlock_wrlock", RealtimeSafetyCheck::locks);
+        return RealtimeSafetyCheck::next<int (*)(pthread_rwlock_t*)>(nextRwlockWrite, "pthread_rwlock_wrlock")(lock);
+    }
+    
+    int pthread_cond_wait(pthread_cond_t* condition, pthread_mutex_t* mutex)
+    {
+        record("pthread_cond_wait", RealtimeSafetyCheck::locks);
+        return RealtimeSafetyCheck::next<int (*)(pthread_cond_t*, pthread_mutex_t*)>(nextCondWait, "pthread_cond_wait")(condition, mutex);
+    }
+    
+    int pthread_cond_timedwait(pthread_cond_t* condition, pthread_mutex_t* mutex, const struct timespec* time)
+    {
+        record("pthread_cond_timedwait", RealtimeSafetyCheck::locks);
+        return RealtimeSafetyCheck::next<int (*)(pthread_cond_t*, pthread_mutex_t*, const struct timespec*)>(nextCondTimedWait, "pthread_cond_timedwait")(condition, mutex, time);
+    }
+    
+    int sem_wait(sem_t* semaphore)
+    {
+        record("sem_wait", RealtimeSafetyCheck::locks);
+        return RealtimeSafetyCheck::next<int (*)(sem_t*)>(nextSemWait, "sem_wait")(semaphore);
+    }
+    
+    int open(const char* path, int flags, ...)
+    {
+        record("open", RealtimeSafetyCheck::systemCalls);
+        mode_t mode = 0;
+        if ((flags & O_CREAT) != 0 || (flags & O_TMPFILE) == O_TMPFILE)
+        {
+            va_list args;
+            va_start(args, flags);
+            mode = static_cast<mode_t>(va_arg(args, int));
+            va_end(args);
+        }
+        return RealtimeSafetyCheck::next<int (*)(const char*, int, ...)>(nextOpen, "open")(path, flags, mode);
+    }
+    
+    int close(int fd)
+    {
+        record("close", RealtimeSafetyCheck::systemCalls);
+        return RealtimeSafetyCheck::next<int (*)(int)>(nextClose, "close")(fd);
+    }
+    
+    ssize_t read(int fd, void* buffer, size_t count)
+    {
+        record("read", RealtimeSafetyCheck::systemCalls);
+        return RealtimeSafetyCheck::next<ssize_t (*)(int, void*, size_t)>(nextRead, "read")(fd, buffer, count);
+    }
+    
+    ssize_t write(int fd, const void* buffer, size_t count)
+    {
+        record("write", RealtimeSafetyCheck::systemCalls);
+        return RealtimeSafetyCheck::next<ssize_t (*)(int, const void*, size_t)>(nextWrite, "write")(fd, buffer, count);
+    }
+    
+    int nanosleep(const struct timespec* duration, struct timespec* remaining)
+    {
+        record("nanosleep", RealtimeSafetyCheck::systemCalls);
+        return RealtimeSafetyCheck::next<int (*)(const struct timespec*, struct timespec*)>(nextNanosleep, "nanosleep")(duration, remaining);
+    }
+    
+    int clock_nanosleep(clockid_t clock, int flags, const struct timespec* time, struct timespec* remaining)
+    {
+        record("clock_nanosleep", RealtimeSafetyCheck::systemCalls);
+        return RealtimeSafetyCheck::next<int (*)(clockid_t, int, const struct timespec*, struct timespec*)>(nextClockNanosleep, "clock_nanosleep")(clock, flags, time, remaining);
+    }
+    
+    int usleep(useconds_t microseconds)
+    {
+        record("usleep", RealtimeSafetyCheck::systemCalls);
+        return RealtimeSafetyCheck::next<int (*)(useconds_t)>(nextUsleep, "usleep")(microseconds);
+    }
+}
+#endif
+
+//==============================================================================
+// The C++ allocator is replaced in every build. A plugin is loaded with dlopen, so libc
+// comes before it in the lookup scope and the malloc family above only sees calls from
+// an executable. The plugin links its own operator new calls to these instead (on ELF
+// with -Bsymbolic-functions), which covers containers and strings growing in its code
+namespace
+{
+    void* allocate(std::size_t size) noexcept
+    {
+        #if defined(__GLIBC__)
+            return __libc_malloc(size == 0 ? 1 : size);
+        #else
+            return std::malloc(size == 0 ? 1 : size);
+        #endif
+    }
+    
+    void release(void* ptr) noexcept
+    {
+        #if defined(__GLIBC__)
+            __libc_free(ptr);
+        #else
+            std::free(ptr);
+        #endif
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    RealtimeSafetyCheck::record("operator new", RealtimeSafetyCheck::heap);
+    if (void* ptr = allocate(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+void operator delete(void* ptr) noexcept { if (ptr != nullptr) RealtimeSafetyCheck::record("operator delete", RealtimeSafetyCheck::heap); release(ptr); }
+void operator delete[](void* ptr) noexcept { operator delete(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { operator delete(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { operator delete(ptr); }
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+//==============================================================================
+// Real-time safety check, built with UNIVERSAL_COMPRESSOR_RT_SAFETY_CHECK.
+// While a thread is inside a ScopedAudioCallback, heap allocation, mutex and
+// semaphore waits and blocking system calls are recorded with their call stack.
+// With UNIVERSAL_COMPRESSOR_RT_SAFETY_ASSERT each one also trips a jassert, so a
+// debugger stops on it.
+//
+// operator new and delete are replaced in every build. In an executable on glibc
+// the libc entry points themselves are intercepted too, so calls from JUCE and the
+// standard library are caught. A plugin is loaded with dlopen, which puts libc
+// ahead of it, so there only its own operator new and delete calls are checked -
+// allocations made inside libstdc++ or libc, and locks and system calls, are not
+namespace RealtimeSafetyCheck
+{
+    // Kinds of call a ScopedAudioCallback records
+    enum Checks
+    {
+        heap = 1,               // Allocation and free
+        locks = 2,              // Mutex, rwlock, condition and semaphore waits
+        systemCalls = 4,        // File I/O and sleeps
+        allChecks = heap | locks | systemCalls
+    };
+    
+    // Marks the calling thread as running the audio callback until destroyed
+    class ScopedAudioCallback
+    {
+    public:
+        explicit ScopedAudioCallback(int checks = allChecks) noexcept;
+        ~ScopedAudioCallback() noexcept;
+    
+    private:
+        const int previous;
+        
+        JUCE_DECLARE_NON_COPYABLE(ScopedAudioCallback)
+    };
+    
+    // Violations since the last reset, including any beyond the recorded stacks
+    int getNumViolations() noexcept;
+    void reset() noexcept;
+    
+    // Recorded violations with symbolised call stacks, identical stacks merged.
+    // Allocates, so call it outside the audio callback
+    juce::String describeViolations();
+}
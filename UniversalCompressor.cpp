@@ -1,6 +1,71 @@
 #include "UniversalCompressor.h"
+#if ! UNIVERSAL_COMPRESSOR_HEADLESS
 #include "EnhancedCompressorEditor.h"
+#endif
 #include <cmath>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#if UNIVERSAL_COMPRESSOR_RT_SAFETY_CHECK
+#include "RealtimeSafetyCheck.h"
+
+// Instrumented build: heap, lock and blocking system calls made inside processBlock
+// are recorded with their call stacks, and assert too when built with
+// UNIVERSAL_COMPRESSOR_RT_SAFETY_CHECK=ASSERT. See RealtimeSafetyCheck.h
+#define UNIVERSAL_COMPRESSOR_AUDIO_CALLBACK_SCOPE RealtimeSafetyCheck::ScopedAudioCallback audioCallbackScope;
+#else
+#define UNIVERSAL_COMPRESSOR_AUDIO_CALLBACK_SCOPE
+#endif
+
+#if UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+// Per-stage profiling: processEngines points the audio thread at the timings of the
+// active mode, and every stage scope adds its elapsed ticks there. Stages outside a
+// processBlock call are not timed
+namespace StageTimer
+{
+    thread_local UniversalCompressor::StageTiming* modeTimings = nullptr;
+    
+    struct ScopedMode
+    {
+        explicit ScopedMode(UniversalCompressor::StageTiming* timings) noexcept : previous(modeTimings) { modeTimings = timings; }
+        ~ScopedMode() noexcept { modeTimings = previous; }
+        UniversalCompressor::StageTiming* const previous;
+    };
+    
+    class Scope
+    {
+    public:
+        Scope(UniversalCompressor::ProfiledStage stage, int numSamples) noexcept
+            : timing(modeTimings != nullptr ? modeTimings + static_cast<int>(stage) : nullptr),
+              samples(numSamples),
+              startTicks(timing != nullptr ? juce::Time::getHighResolutionTicks() : 0)
+        {
+        }
+        
+        ~Scope() noexcept
+        {
+            if (timing == nullptr)
+                return;
+            timing->ticks += static_cast<juce::uint64>(juce::Time::getHighResolutionTicks() - startTicks);
+            timing->calls += 1;
+            timing->samples += static_cast<juce::uint64>(samples);
+        }
+        
+    private:
+        UniversalCompressor::StageTiming* const timing;
+        const int samples;
+        const juce::int64 startTicks;
+        
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+}
+
+// Times the rest of the enclosing block as the given ProfiledStage over numSamples host-rate frames
+#define UNIVERSAL_COMPRESSOR_STAGE_TIMER(stage, numSamples) StageTimer::Scope JUCE_JOIN_MACRO(stageTimer, __LINE__)(UniversalCompressor::ProfiledStage::stage, numSamples);
+#else
+#define UNIVERSAL_COMPRESSOR_STAGE_TIMER(stage, numSamples)
+#endif
 
 // Named constants for improved code readability
 namespace Constants {
@@ -36,30 +101,147 @@ namespace Constants {
     constexpr float NYQUIST_SAFETY_FACTOR = 0.45f; // 45% of sample rate
     constexpr float MAX_CUTOFF_FREQ = 20000.0f; // 20kHz
     
+    // Stereo link amount at which every channel shares one gain computer
+    constexpr float FULL_STEREO_LINK = 0.999f;
+    
+    // Longest lookahead the audio path delay is allocated for
+    constexpr float MAX_LOOKAHEAD_MS = 10.0f;
+    
+    // Idle skip: input floor (-120 dBFS) and the gain reduction that counts as recovered
+    constexpr float IDLE_FLOOR = 1.0e-6f;
+    constexpr float IDLE_MAX_REDUCTION_DB = 0.01f;
+    
     // Safety limits
     constexpr float OUTPUT_HARD_LIMIT = 2.0f;
     constexpr float EPSILON = 0.0001f; // Small value to prevent division by zero
 }
 
+// Read-only gain reduction meter for hosts that display one (VST3/AU meter category).
+// The host reads the processor's meter atomic whenever it polls, so the audio thread
+// never writes a parameter and nothing shows up as automation. Hosts that only follow
+// parameter notifications don't animate it - it is never sent to them as an edit, and
+// it is left out of the saved state
+class GainReductionMeterParameter : public juce::AudioParameterFloat
+{
+public:
+    static constexpr const char* ID = "gr_meter";
+    
+    explicit GainReductionMeterParameter(const std::atomic<float>& source)
+        : juce::AudioParameterFloat(ID, "GR",
+                                    juce::NormalisableRange<float>(-30.0f, 0.0f, 0.1f), 0.0f,
+                                    juce::AudioParameterFloatAttributes()
+                                        .withLabel("dB")
+                                        .withAutomatable(false)
+                                        .withCategory(juce::AudioProcessorParameter::compressorLimiterGainReductionMeter)),
+          meter(source)
+    {
+    }
+    
+    float getValue() const override
+    {
+        return convertTo0to1(juce::jlimit(-30.0f, 0.0f, meter.load(std::memory_order_relaxed)));
+    }
+    
+    // Output only - a saved reading would mark the project modified and be replayed on load
+    static void removeFromState(juce::ValueTree& state)
+    {
+        for (int i = state.getNumChildren(); --i >= 0;)
+            if (state.getChild(i).getProperty("id").toString() == ID)
+                state.removeChild(i, nullptr);
+    }
+    
+private:
+    const std::atomic<float>& meter;
+};
+
+// Lookup table implementations
+void UniversalCompressor::LookupTables::initialize()
+{
+    // Precompute exponential values for range -4 to 0 (typical for envelope coefficients)
+    // Grid positions are computed in double so entries next to x = 0 stay accurate
+    for (int i = 0; i < TABLE_SIZE; ++i)
+    {
+        double x = -4.0 + (4.0 * i / static_cast<double>(TABLE_SIZE - 1));
+        expTable[i] = static_cast<float>(std::exp(x));
+    }
+    
+    // Precompute logarithm values for range 0.0001 to 1.0
+    for (int i = 0; i < TABLE_SIZE; ++i)
+    {
+        float x = 0.0001f + (0.9999f * i / static_cast<float>(TABLE_SIZE - 1));
+        logTable[i] = std::log(x);
+    }
+}
+
+inline float UniversalCompressor::LookupTables::fastExp(float x) const
+{
+    // Clamp to table range
+    x = juce::jlimit(-4.0f, 0.0f, x);
+    // Measure the position from the x = 0 end of the table so the tiny arguments
+    // produced by long envelope times keep their precision
+    const float position = -x * static_cast<float>(TABLE_SIZE - 1) * 0.25f;
+    const int offset = juce::jlimit(0, TABLE_SIZE - 2, static_cast<int>(position));
+    const float frac = position - static_cast<float>(offset);
+    // Linear interpolation between neighbouring entries
+    const int index = TABLE_SIZE - 1 - offset;
+    return expTable[index] + frac * (expTable[index - 1] - expTable[index]);
+}
+
+inline float UniversalCompressor::LookupTables::fastLog(float x) const
+{
+    // Clamp to table range
+    x = juce::jlimit(0.0001f, 1.0f, x);
+    // Map to table index
+    int index = static_cast<int>((x - 0.0001f) * (TABLE_SIZE - 1) / 0.9999f);
+    index = juce::jlimit(0, TABLE_SIZE - 1, index);
+    return logTable[index];
+}
+
+inline float UniversalCompressor::LookupTables::envelopeCoefficient(float timeSeconds, float sampleRate) const
+{
+    // Table-based exp(-1 / (time * sampleRate)) for program-dependent envelope times
+    return fastExp(-1.0f / juce::jmax(Constants::EPSILON, timeSeconds * sampleRate));
+}
+
 // Unified Anti-aliasing system for all compressor types
+template <typename SampleType>
 class UniversalCompressor::AntiAliasing
 {
 public:
     AntiAliasing() = default;
     
-    void prepare(double sampleRate, int blockSize, int numChannels)
+    // numStages is the oversampling factor as a power of two (0 = 1x ... 3 = 8x)
+    void prepare(double sampleRate, int blockSize, int numChannels, int numStages, bool linearPhase)
     {
         this->sampleRate = sampleRate;
         this->numChannels = numChannels;
         
+        // Filter coefficients only depend on the sample rate
+        if (sampleRate > 0.0)
+        {
+            // Fixed higher cutoff to preserve harmonics
+            preFilterCoeff = std::exp(-2.0f * 3.14159f * 20000.0f / static_cast<float>(sampleRate));
+            // 45% of sample rate, max 20kHz
+            const float postCutoff = std::min(20000.0f, static_cast<float>(sampleRate * 0.45f));
+            postFilterCoeff = std::exp(-2.0f * 3.14159f * postCutoff / static_cast<float>(sampleRate));
+        }
+        
         if (blockSize > 0 && numChannels > 0)
         {
-            // Use 2x oversampling (1 stage) for better performance
-            // 1 stage = 2x oversampling as the button indicates
-            oversampler = std::make_unique<juce::dsp::Oversampling<float>>(
-                numChannels, 1, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
-                juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR);
-            oversampler->initProcessing(static_cast<size_t>(blockSize));
+            // Polyphase IIR is minimum phase with low latency, equiripple FIR is linear phase
+            const auto filterType = linearPhase ? juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple
+                                                : juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR;
+            numStages = juce::jlimit(0, 3, numStages);
+            
+            // At 1x there is no oversampler at all and the output stages run on the host block
+            oversampler.reset();
+            if (numStages > 0)
+            {
+                oversampler = std::make_unique<juce::dsp::Oversampling<SampleType>>(
+                    numChannels, static_cast<size_t>(numStages), filterType);
+                oversampler->initProcessing(static_cast<size_t>(blockSize));
+            }
+
             
             // Initialize per-channel filter states
             channelStates.resize(numChannels);
@@ -73,19 +255,20 @@ public:
         }
     }
     
-    juce::dsp::AudioBlock<float> processUp(juce::dsp::AudioBlock<float>& block)
+    juce::dsp::AudioBlock<SampleType> processUp(juce::dsp::AudioBlock<SampleType>& block)
     {
         if (oversampler)
             return oversampler->processSamplesUp(block);
         return block;
     }
     
-    void processDown(juce::dsp::AudioBlock<float>& block)
+    void processDown(juce::dsp::AudioBlock<SampleType>& block)
     {
         if (oversampler)
             oversampler->processSamplesDown(block);
     }
     
+
     // Unified pre-saturation filtering to prevent aliasing
     float preProcessSample(float input, int channel)
     {
@@ -94,8 +277,7 @@ public:
         // Gentle high-frequency reduction before any saturation
         // This prevents high frequencies from creating aliases
         // Use gentler filtering to preserve harmonics
-        const float cutoffFreq = 20000.0f;  // Fixed higher cutoff to preserve harmonics
-        const float filterCoeff = std::exp(-2.0f * 3.14159f * cutoffFreq / static_cast<float>(sampleRate));
+        const float filterCoeff = preFilterCoeff;
         
         channelStates[channel].preFilterState = input * (1.0f - filterCoeff * 0.1f) + 
                                                 channelStates[channel].preFilterState * filterCoeff * 0.1f;
@@ -111,8 +293,7 @@ public:
         // Remove any harmonics above Nyquist/2
         // Only process if we have a valid sample rate from DAW
         if (sampleRate <= 0.0) return input;
-        const float cutoffFreq = std::min(20000.0f, static_cast<float>(sampleRate * 0.45f));  // 45% of sample rate, max 20kHz
-        const float filterCoeff = std::exp(-2.0f * 3.14159f * cutoffFreq / static_cast<float>(sampleRate));
+        const float filterCoeff = postFilterCoeff;
         
         channelStates[channel].postFilterState = input * (1.0f - filterCoeff * 0.05f) + 
                                                  channelStates[channel].postFilterState * filterCoeff * 0.05f;
@@ -166,6 +347,7 @@ public:
     }
     
     bool isOversamplingEnabled() const { return oversampler != nullptr; }
+    int getOversamplingFactor() const { return oversampler ? static_cast<int>(oversampler->getOversamplingFactor()) : 1; }
     double getSampleRate() const { return sampleRate; }
 
 private:
@@ -177,10 +359,215 @@ private:
         float dcBlockerPrev = 0.0f;
     };
     
-    std::unique_ptr<juce::dsp::Oversampling<float>> oversampler;
+    std::unique_ptr<juce::dsp::Oversampling<SampleType>> oversampler;
+
     std::vector<ChannelState> channelStates;
     double sampleRate = 0.0;  // Set by prepare() from DAW
     int numChannels = 0;  // Set by prepare() from DAW
+    float preFilterCoeff = 0.0f;   // Cached in prepare()
+    float postFilterCoeff = 0.0f;  // Cached in prepare()
+};
+
+// Lookahead delay for the audio path. The detectors keep reading the undelayed
+// input, so gain reduction is already in place when a transient reaches the output
+template <typename SampleType>
+class UniversalCompressor::LookaheadDelay
+{
+public:
+    LookaheadDelay() = default;
+    
+    void prepare(int numChannels, int maxDelaySamples)
+    {
+        // One extra slot so the longest delay never reads the sample just written
+        bufferSize = juce::jmax(1, maxDelaySamples + 1);
+        buffer.setSize(juce::jmax(1, numChannels), bufferSize);
+        reset();
+    }
+    
+    void reset()
+    {
+        buffer.clear();
+        writePosition = 0;
+        isClear = true;
+    }
+    
+    int getMaxDelay() const { return bufferSize - 1; }
+    
+    // Drops the history, so a delay that starts running again never replays stale input
+    void flush()
+    {
+        if (!isClear)
+            reset();
+    }
+    
+    // Delays every channel in place. A zero delay leaves the audio untouched and
+    // flushes the old history so re-enabling lookahead never replays stale input
+    void process(SampleType* const* channels, int numChannels, int numSamples, int delaySamples)
+    {
+        delaySamples = juce::jlimit(0, bufferSize - 1, delaySamples);
+        if (delaySamples == 0)
+        {
+            flush();
+            return;
+        }
+        isClear = false;
+        
+        numChannels = juce::jmin(numChannels, buffer.getNumChannels());
+        const int startReadPosition = (writePosition - delaySamples + bufferSize) % bufferSize;
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            SampleType* data = channels[channel];
+            SampleType* ring = buffer.getWritePointer(channel);
+            int write = writePosition;
+            int read = startReadPosition;
+            
+            for (int i = 0; i < numSamples; ++i)
+            {
+                ring[write] = data[i];
+                data[i] = ring[read];
+                if (++write == bufferSize) write = 0;
+                if (++read == bufferSize) read = 0;
+            }
+        }
+        writePosition = static_cast<int>((writePosition + static_cast<int64_t>(numSamples)) % bufferSize);
+    }
+
+private:
+    juce::AudioBuffer<SampleType> buffer;
+    int bufferSize = 1;
+    int writePosition = 0;
+    bool isClear = true;
+};
+
+// Linkwitz-Riley band splitter for multiband mode. Each crossover splits what is left
+// above the previous one, and the bands already split off pass through a matching
+// allpass so all bands sum back flat. Bands are laid out one after another - band b of
+// channel c lands in channel b * numChannels + c - so an engine runs them as extra channels
+template <typename SampleType>
+class UniversalCompressor::BandSplitter
+{
+public:
+    BandSplitter() = default;
+    
+    void prepare(double sampleRate, int numChannels, int maxBlockSize)
+    {
+        this->sampleRate = sampleRate;
+        const juce::dsp::ProcessSpec spec{sampleRate, static_cast<juce::uint32>(juce::jmax(1, maxBlockSize)),
+                                          static_cast<juce::uint32>(juce::jmax(1, numChannels))};
+        for (auto& crossover : crossovers)
+            crossover.prepare(spec);
+        for (auto& bandAllpasses : allpasses)
+        {
+            for (auto& allpass : bandAllpasses)
+            {
+                allpass.setType(juce::dsp::LinkwitzRileyFilterType::allpass);
+                allpass.prepare(spec);
+            }
+        }
+        bands.setSize(juce::jmax(1, numChannels) * MAX_BANDS, juce::jmax(1, maxBlockSize));
+        frequencies.fill(0.0f);
+        activeBands = 0;
+    }
+    
+    void reset()
+    {
+        for (auto& crossover : crossovers)
+            crossover.reset();
+        for (auto& bandAllpasses : allpasses)
+            for (auto& allpass : bandAllpasses)
+                allpass.reset();
+    }
+    
+    // Splits input into numBands bands and returns them as one block of numBands times
+    // the input channels. crossoverHz holds the numBands - 1 crossovers, low to high
+    juce::dsp::AudioBlock<SampleType> split(const juce::dsp::AudioBlock<const SampleType>& input, int numBands,
+                                            const std::array<float, MAX_BANDS - 1>& crossoverHz)
+    {
+        numBands = juce::jlimit(2, MAX_BANDS, numBands);
+        const int numChannels = juce::jmin(static_cast<int>(input.getNumChannels()), bands.getNumChannels() / MAX_BANDS);
+        const int numSamples = juce::jmin(static_cast<int>(input.getNumSamples()), bands.getNumSamples());
+        jassert(numSamples == static_cast<int>(input.getNumSamples()));  // The processor splits blocks to the prepared size
+        
+        // A different band count starts the filters from silence
+        if (numBands != activeBands)
+        {
+            reset();
+            activeBands = numBands;
+        }
+        updateFrequencies(numBands, crossoverHz);
+        
+        std::array<SampleType*, MAX_BANDS> bandData{};
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            const SampleType* in = input.getChannelPointer(static_cast<size_t>(channel));
+            for (int band = 0; band < numBands; ++band)
+                bandData[static_cast<size_t>(band)] = bands.getWritePointer(band * numChannels + channel);
+            
+            for (int i = 0; i < numSamples; ++i)
+            {
+                SampleType rest = in[i];
+                for (int stage = 0; stage < numBands - 1; ++stage)
+                {
+                    // Bands below this crossover take its phase shift as well
+                    for (int band = 0; band < stage; ++band)
+                    {
+                        auto& sample = bandData[static_cast<size_t>(band)][i];
+                        sample = allpasses[static_cast<size_t>(band)][static_cast<size_t>(stage)].processSample(channel, sample);
+                    }
+                    
+                    SampleType low, high;
+                    crossovers[static_cast<size_t>(stage)].processSample(channel, rest, low, high);
+                    bandData[static_cast<size_t>(stage)][i] = low;
+                    rest = high;
+                }
+                bandData[static_cast<size_t>(numBands - 1)][i] = rest;
+            }
+        }
+        
+        return juce::dsp::AudioBlock<SampleType>(bands)
+            .getSubsetChannelBlock(0, static_cast<size_t>(numChannels * numBands))
+            .getSubBlock(0, static_cast<size_t>(numSamples));
+    }
+    
+    // Sums the bands from split() back into output
+    static void sum(const juce::dsp::AudioBlock<SampleType>& bandBlock, const juce::dsp::AudioBlock<SampleType>& output,
+                    int numBands)
+    {
+        const size_t numChannels = output.getNumChannels();
+        output.copyFrom(bandBlock.getSubsetChannelBlock(0, numChannels));
+        for (int band = 1; band < numBands; ++band)
+            output.add(bandBlock.getSubsetChannelBlock(static_cast<size_t>(band) * numChannels, numChannels));
+    }
+
+private:
+    // Crossovers are kept in order and below Nyquist however the parameters are set.
+    // The filters are only retuned when a frequency actually moves
+    void updateFrequencies(int numBands, const std::array<float, MAX_BANDS - 1>& crossoverHz)
+    {
+        const float maxFrequency = static_cast<float>(sampleRate * 0.45);
+        float lowest = 20.0f;
+        for (int stage = 0; stage < numBands - 1; ++stage)
+        {
+            const auto index = static_cast<size_t>(stage);
+            const float frequency = juce::jmin(juce::jmax(crossoverHz[index], lowest), maxFrequency);
+            lowest = frequency * 1.25f;
+            if (frequency == frequencies[index])
+                continue;
+            
+            frequencies[index] = frequency;
+            crossovers[index].setCutoffFrequency(static_cast<SampleType>(frequency));
+            for (int band = 0; band < stage; ++band)
+                allpasses[static_cast<size_t>(band)][index].setCutoffFrequency(static_cast<SampleType>(frequency));
+        }
+    }
+    
+    std::array<juce::dsp::LinkwitzRileyFilter<SampleType>, MAX_BANDS - 1> crossovers;
+    // Phase compensation, indexed [band][crossover] for crossovers above the band
+    std::array<std::array<juce::dsp::LinkwitzRileyFilter<SampleType>, MAX_BANDS - 1>, MAX_BANDS - 2> allpasses;
+    std::array<float, MAX_BANDS - 1> frequencies{};
+    juce::AudioBuffer<SampleType> bands;
+    double sampleRate = 44100.0;
+    int activeBands = 0;
 };
 
 // Helper function to get harmonic scaling based on saturation mode
@@ -211,13 +598,181 @@ inline void getHarmonicScaling(int saturationMode, float& h2Scale, float& h3Scal
     }
 }
 
+// Sidechain detector lanes for the feed-forward engines: one SIMD register holds the
+// same detector field for a group of channels (4 floats on SSE and NEON), so stereo
+// and quad detectors advance together in the same instructions
+using DetectorLanes = juce::dsp::SIMDRegister<float>;
+constexpr int DETECTOR_LANES = static_cast<int>(DetectorLanes::SIMDNumElements);
+
+inline size_t getNumDetectorGroups(int numChannels)
+{
+    return static_cast<size_t>((juce::jmax(0, numChannels) + DETECTOR_LANES - 1) / DETECTOR_LANES);
+}
+
+// Scratch frames holding one sample of every channel in a lane group.
+// The detector kernels run in place over these before the per-channel gain stage
+class DetectorFrames
+{
+public:
+    void prepare(int maxSamples)
+    {
+        frames.assign(static_cast<size_t>(juce::jmax(1, maxSamples)), DetectorLanes::expand(0.0f));
+    }
+    
+    int getCapacity() const { return static_cast<int>(frames.size()); }
+    
+    // Gather up to DETECTOR_LANES channels, unused lanes stay silent.
+    // Detection runs in float for either processing precision
+    template <typename SampleType>
+    void load(const SampleType* const* channels, int numChannels, int startSample, int numSamples)
+    {
+        alignas(DetectorLanes::SIMDRegisterSize) float frame[DETECTOR_LANES] = {};
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (int lane = 0; lane < numChannels; ++lane)
+                frame[lane] = static_cast<float>(channels[lane][startSample + i]);
+            frames[static_cast<size_t>(i)] = DetectorLanes::fromRawArray(frame);
+        }
+    }
+    
+    DetectorLanes& operator[](int index) { return frames[static_cast<size_t>(index)]; }
+    float get(int index, int lane) const { return frames[static_cast<size_t>(index)].get(static_cast<size_t>(lane)); }
+    
+private:
+    std::vector<DetectorLanes> frames;
+};
+
+// Stereo-link groups: runs of consecutive engine channels linked with each other and
+// not with the rest. Multiband mode links each band on its own, surround buses split
+// the front, surround, height and LFE channels
+class LinkGroups
+{
+public:
+    static constexpr int MAX_GROUPS = 64;
+    
+    void clear() { numGroups = 0; }
+    
+    void add(int numChannels)
+    {
+        if (numChannels <= 0 || numGroups >= MAX_GROUPS)
+            return;
+        
+        starts[static_cast<size_t>(numGroups + 1)] = starts[static_cast<size_t>(numGroups)] + numChannels;
+        ++numGroups;
+    }
+    
+    int getNumGroups() const { return numGroups; }
+    int getFirstChannel(int group) const { return starts[static_cast<size_t>(group)]; }
+    int getNumChannels(int group) const { return starts[static_cast<size_t>(group + 1)] - starts[static_cast<size_t>(group)]; }
+    
+    // Group holding channel, channels past the end belong to the last group
+    int findGroup(int channel) const
+    {
+        int group = 0;
+        while (group < numGroups - 1 && channel >= starts[static_cast<size_t>(group + 1)])
+            ++group;
+        return group;
+    }
+    
+    bool linksAnyChannels() const
+    {
+        for (int group = 0; group < numGroups; ++group)
+            if (getNumChannels(group) > 1)
+                return true;
+        return false;
+    }
+    
+    // The groups covering the first numChannels channels. No groups links every channel,
+    // channels beyond the described groups are linked together
+    static LinkGroups forChannels(const LinkGroups* requested, int numChannels)
+    {
+        LinkGroups groups;
+        int covered = 0;
+        
+        if (requested != nullptr)
+        {
+            for (int group = 0; group < requested->getNumGroups() && covered < numChannels; ++group)
+            {
+                const int size = juce::jmin(requested->getNumChannels(group), numChannels - covered);
+                groups.add(size);
+                covered += size;
+            }
+        }
+        
+        groups.add(numChannels - covered);
+        return groups;
+    }
+    
+private:
+    std::array<int, MAX_GROUPS + 1> starts{};   // Group g is channels starts[g] to starts[g + 1] - 1
+    int numGroups = 0;
+};
+
+// Stereo link for the feed-forward engines, which detect every lane group into
+// its own frames before any gain stage runs.
+// Loudest detector level across one link group's channels for each frame
+inline void findLoudestLevels(std::vector<DetectorFrames>& frames, int firstChannel, int numChannels,
+                              int numSamples, float* loudest)
+{
+    const int lastChannel = firstChannel + numChannels;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        float level = 0.0f;
+        for (int channel = firstChannel; channel < lastChannel; ++channel)
+            level = juce::jmax(level, frames[static_cast<size_t>(channel / DETECTOR_LANES)].get(i, channel % DETECTOR_LANES));
+        loudest[i] = level;
+    }
+}
+
+// Partial link: pull every channel's detector level toward the loudest channel of its
+// link group. loudest holds one row of levels per link group, stride samples apart
+inline void blendTowardLoudest(DetectorFrames& frames, int firstChannel, const float* loudest, int stride,
+                               const LinkGroups& linkGroups, int numSamples, float link)
+{
+    // Unused lanes follow the last group, their levels are never read
+    std::array<const float*, DETECTOR_LANES> rows;
+    for (int lane = 0; lane < DETECTOR_LANES; ++lane)
+        rows[static_cast<size_t>(lane)] = loudest + linkGroups.findGroup(firstChannel + lane) * stride;
+    
+    // All lanes in one link group - the stereo case - broadcast a single level
+    if (std::all_of(rows.begin(), rows.end(), [&](const float* row) { return row == rows[0]; }))
+    {
+        for (int i = 0; i < numSamples; ++i)
+            frames[i] = frames[i] + (DetectorLanes::expand(rows[0][i]) - frames[i]) * link;
+        return;
+    }
+    
+    alignas(DetectorLanes::SIMDRegisterSize) float target[DETECTOR_LANES];
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (int lane = 0; lane < DETECTOR_LANES; ++lane)
+            target[lane] = rows[static_cast<size_t>(lane)][i];
+        frames[i] = frames[i] + (DetectorLanes::fromRawArray(target) - frames[i]) * link;
+    }
+}
+
+// Final safety clip shared by all engines
+template <typename SampleType>
+inline SampleType limitOutput(SampleType sample)
+{
+    const auto limit = static_cast<SampleType>(Constants::OUTPUT_HARD_LIMIT);
+    return juce::jlimit(-limit, limit, sample);
+}
+
 // Opto Compressor (LA-2A style)
+// Audio path runs in SampleType, detection and gain computer in float
+template <typename SampleType>
 class UniversalCompressor::OptoCompressor
 {
 public:
-    void prepare(double sampleRate, int numChannels)
+    explicit OptoCompressor(const LookupTables& tables) : lookupTables(tables) {}
+    
+    // The T4 cell runs at the host rate, the tube stage at saturationFactor times it
+    void prepare(double sampleRate, int numChannels, int saturationFactor)
     {
         this->sampleRate = sampleRate;
+        this->saturationFactor = juce::jmax(1, saturationFactor);
+        updateCoefficients();
         detectors.resize(numChannels);
         for (auto& detector : detectors)
         {
@@ -231,64 +786,245 @@ public:
             detector.releasePhase = 0;
             detector.maxReduction = 0.0f;
             detector.holdCounter = 0.0f;
-            detector.saturationLowpass = 0.0f; // Initialize anti-aliasing filter
-            detector.prevInput = 0.0f; // Initialize previous input
         }
-        
-        // PROFESSIONAL FIX: Always create 2x oversampler for saturation
-        // This ensures harmonics are consistent regardless of user setting
-        saturationOversampler = std::make_unique<juce::dsp::Oversampling<float>>(
-            1, // Single channel processing
-            1, // 1 stage = 2x oversampling
-            juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
-            juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR
-        );
-        saturationOversampler->initProcessing(1); // Single sample processing
+        outputStages.assign(static_cast<size_t>(numChannels), OutputStage{});
+        linkLevels.assign(static_cast<size_t>(numChannels), 0.0f);
     }
     
-    float process(float input, int channel, float peakReduction, float gain, bool limitMode, bool oversample = false)
+    // Block-rate parameters, read once per processBlock call
+    struct Params
     {
-        if (channel >= static_cast<int>(detectors.size()))
-            return input;
+        float peakReduction = 0.0f;  // 0-100, sidechain amplifier gain
+        float gain = 0.0f;           // Makeup gain in dB (-40 to +40)
+        bool limitMode = false;
+        float stereoLink = 0.0f;     // 0-1, pull toward the loudest channel
+        const LinkGroups* linkGroups = nullptr;  // Channels linked together, nullptr = all of them
+    };
+    
+    // Detection and gain cell at the host rate. Leaves the compressed signal in
+    // channelData for processSaturation.
+    // keyData holds one detector key per channel, or nullptr to key each channel from itself
+    void processBlock(SampleType* const* channelData, const SampleType* const* keyData,
+                      int numChannels, int numSamples, const Params& params)
+    {
+        if (channelData == nullptr)
+            return;
+        if (keyData == nullptr)
+            keyData = channelData;
         
         // Safety check for sample rate
         if (sampleRate <= 0.0)
-            return input;
+            return;
         
-        // Validate parameters
-        peakReduction = juce::jlimit(0.0f, 100.0f, peakReduction);
-        gain = juce::jlimit(-40.0f, 40.0f, gain);
+        // The detector listens to the gain cell's output, so detection, gain computer
+        // and envelope are one per-sample loop and are profiled as one stage
+        UNIVERSAL_COMPRESSOR_STAGE_TIMER(GainEnvelope, numSamples)
         
-        #ifdef DEBUG
-        jassert(!std::isnan(input) && !std::isinf(input));
-        jassert(sampleRate > 0.0);
-        #endif
-            
-        auto& detector = detectors[channel];
+        // Validate parameters and derive gains once for the whole block.
+        // The state is kept for the saturation pass over the same block
+        BlockState& state = blockState;
+        state = BlockState{};
+        
+        // Peak Reduction controls the sidechain amplifier gain (essentially threshold)
+        // 0-100 maps to 0dB to -40dB threshold (inverted control)
+        const float peakReduction = juce::jlimit(0.0f, 100.0f, params.peakReduction);
+        state.sidechainGain = juce::Decibels::decibelsToGain(peakReduction * 0.4f); // 0 to +40dB
+        state.makeupGain = juce::Decibels::decibelsToGain(juce::jlimit(-40.0f, 40.0f, params.gain));
         
-        // Apply gain reduction (feedback topology)
-        float compressed = input * detector.envelope;
+        const int channelsToProcess = juce::jmin(numChannels, static_cast<int>(detectors.size()));
+        const LinkGroups linkGroups = LinkGroups::forChannels(params.linkGroups, channelsToProcess);
+        state.link = linkGroups.linksAnyChannels() ? juce::jlimit(0.0f, 1.0f, params.stereoLink) : 0.0f;
+        
+        // The T4 cell is driven from the output (feedback). Linked channels have to
+        // advance together sample by sample, unlinked ones run their own sample loops.
+        // Each link group is linked on its own
+        if (state.link > 0.0f)
+        {
+            const auto kernel = getLinkedKernel(params.limitMode, state.link >= Constants::FULL_STEREO_LINK);
+            for (int group = 0; group < linkGroups.getNumGroups(); ++group)
+                (this->*kernel)(channelData, keyData, linkGroups.getFirstChannel(group), linkGroups.getNumChannels(group),
+                                numSamples, state);
+            return;
+        }
+        
+        // Mode flags select a specialised kernel once per block
+        const auto kernel = getChannelKernel(params.limitMode);
+        for (int channel = 0; channel < channelsToProcess; ++channel)
+            (this->*kernel)(channelData[channel], keyData[channel], numSamples, detectors[static_cast<size_t>(channel)], state);
+    }
+    
+    // Tube output stage over the block processBlock just compressed, run at the
+    // saturation rate - numSamples is the host block times the saturation factor
+    void processSaturation(SampleType* const* channelData, int numChannels, int numSamples)
+    {
+        if (channelData == nullptr || sampleRate <= 0.0)
+            return;
+        
+        const int channelsToProcess = juce::jmin(numChannels, static_cast<int>(outputStages.size()));
+        const auto kernel = saturationFactor > 1 ? &OptoCompressor::processOutputChannel<true>
+                                                 : &OptoCompressor::processOutputChannel<false>;
+        for (int channel = 0; channel < channelsToProcess; ++channel)
+            (this->*kernel)(channelData[channel], numSamples, outputStages[static_cast<size_t>(channel)]);
+    }
+    
+    float getGainReduction(int channel) const
+    {
+        if (channel >= static_cast<int>(detectors.size()))
+            return 0.0f;
+        return juce::Decibels::gainToDecibels(detectors[channel].envelope);
+    }
+
+private:
+    struct Detector
+    {
+        float envelope = 1.0f;
+        float rms = 0.0f;
+        float releaseStartLevel = 1.0f;  // For two-stage release
+        int releasePhase = 0;             // 0=idle, 1=fast, 2=slow
+        float maxReduction = 0.0f;       // Track max reduction for program dependency
+        float holdCounter = 0.0f;        // Track how long compression is held
+        float lightMemory = 0.0f;        // T4 cell light memory
+        float previousReduction = 0.0f;  // Previous reduction for delta tracking
+        float hfFilter = 0.0f;           // High frequency filter state
+        float releaseStartTime = 0.0f;   // Time since release started
+    };
+    
+    // Per-channel tube and transformer state, separate from the detector so
+    // linked channels can share one T4 cell
+    struct OutputStage
+    {
+        SampleType saturationLowpass = 0;  // Anti-aliasing filter state
+    };
+    
+    // Per-block invariants derived from Params
+    struct BlockState
+    {
+        float sidechainGain = 1.0f;
+        float makeupGain = 1.0f;
+        float link = 0.0f;               // Stereo link, 0 when channels run independently
+    };
+    
+    // Sample loops specialised on the per-block mode flags, so the inner loop has no flag branches
+    using ChannelKernel = void (OptoCompressor::*)(SampleType*, const SampleType*, int, Detector&, const BlockState&);
+    using LinkedKernel = void (OptoCompressor::*)(SampleType* const*, const SampleType* const*, int, int, int, const BlockState&);
+    
+    static ChannelKernel getChannelKernel(bool limitMode)
+    {
+        return limitMode ? &OptoCompressor::processChannel<true> : &OptoCompressor::processChannel<false>;
+    }
+    
+    static LinkedKernel getLinkedKernel(bool limitMode, bool fullLink)
+    {
+        // Indexed [limitMode][fullLink]
+        static constexpr LinkedKernel kernels[2][2] = {
+            { &OptoCompressor::processLinked<false, false>, &OptoCompressor::processLinked<false, true> },
+            { &OptoCompressor::processLinked<true, false>,  &OptoCompressor::processLinked<true, true> }
+        };
+        return kernels[limitMode ? 1 : 0][fullLink ? 1 : 0];
+    }
+    
+    template <bool LimitMode>
+    void processChannel(SampleType* data, const SampleType* key, int numSamples, Detector& detector,
+                        const BlockState& state)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            #ifdef DEBUG
+            jassert(!std::isnan(data[i]) && !std::isinf(data[i]));
+            #endif
+            
+            // Apply gain reduction (feedback topology)
+            SampleType compressed = data[i] * detector.envelope;
+            updateCell<LimitMode>(detect<LimitMode>(key[i], detector, state), detector);
+            data[i] = compressed;
+        }
+    }
+    
+    template <bool Oversample>
+    void processOutputChannel(SampleType* data, int numSamples, OutputStage& output)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = processOutputStage<Oversample>(data[i], output, blockState);
+    }
+    
+    // Linked channels firstChannel onwards, advanced together one sample at a time. Fully
+    // linked, the group's first T4 cell sees the loudest channel and its gain drives every
+    // channel. Partially linked, each cell sees its own level pulled toward the loudest one
+    template <bool LimitMode, bool FullLink>
+    void processLinked(SampleType* const* channelData, const SampleType* const* keyData,
+                       int firstChannel, int numChannels, int numSamples, const BlockState& state)
+    {
+        const int lastChannel = firstChannel + numChannels;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if constexpr (FullLink)
+            {
+                auto& detector = detectors[static_cast<size_t>(firstChannel)];
+                float loudest = 0.0f;
+                for (int channel = firstChannel; channel < lastChannel; ++channel)
+                    loudest = juce::jmax(loudest, detect<LimitMode>(keyData[channel][i], detector, state));
+                
+                // Gain is applied before the cell updates, as in the per-channel loop
+                const float gain = detector.envelope;
+                updateCell<LimitMode>(loudest, detector);
+                
+                for (int channel = firstChannel; channel < lastChannel; ++channel)
+                    channelData[channel][i] = channelData[channel][i] * gain;
+            }
+            else
+            {
+                float loudest = 0.0f;
+                for (int channel = firstChannel; channel < lastChannel; ++channel)
+                {
+                    const auto index = static_cast<size_t>(channel);
+                    linkLevels[index] = detect<LimitMode>(keyData[channel][i], detectors[index], state);
+                    loudest = juce::jmax(loudest, linkLevels[index]);
+                }
+                
+                for (int channel = firstChannel; channel < lastChannel; ++channel)
+                {
+                    const auto index = static_cast<size_t>(channel);
+                    auto& detector = detectors[index];
+                    SampleType compressed = channelData[channel][i] * detector.envelope;
+                    updateCell<LimitMode>(linkLevels[index] + (loudest - linkLevels[index]) * state.link, detector);
+                    channelData[channel][i] = compressed;
+                }
+            }
+        }
         
+        // Fully linked channels share the group's first cell, keep the rest in step for metering
+        if constexpr (FullLink)
+            std::fill(detectors.begin() + firstChannel + 1, detectors.begin() + lastChannel, detectors[static_cast<size_t>(firstChannel)]);
+    }
+    
+    // Sidechain level seen by the T4 cell for one sample
+    template <bool LimitMode>
+    float detect(SampleType key, const Detector& detector, const BlockState& state) const
+    {
         // LA-2A feedback topology: detection from output
         // In Compress mode: sidechain = output
         // In Limit mode: sidechain = 1/25 input + 24/25 output
-        float sidechainSignal;
-        if (limitMode)
+        // An external key is passed through the same gain cell so the loop keeps its feedback response
+        SampleType compressedKey = key * detector.envelope;
+        SampleType sidechainSignal;
+        if constexpr (LimitMode)
         {
             // Limit mode mixes a small amount of input with output
-            sidechainSignal = input * 0.04f + compressed * 0.96f;
+            sidechainSignal = key * 0.04f + compressedKey * 0.96f;
         }
         else
         {
             // Compress mode uses pure output feedback
-            sidechainSignal = compressed;
+            sidechainSignal = compressedKey;
         }
         
-        // Peak Reduction controls the sidechain amplifier gain (essentially threshold)
-        // 0-100 maps to 0dB to -40dB threshold (inverted control)
-        float sidechainGain = juce::Decibels::decibelsToGain(peakReduction * 0.4f); // 0 to +40dB
-        float detectionLevel = std::abs(sidechainSignal * sidechainGain);
-        
+        return static_cast<float>(std::abs(sidechainSignal * state.sidechainGain));
+    }
+    
+    // T4 optical cell: light memory, variable ratio and two-stage release for one sample
+    template <bool LimitMode>
+    void updateCell(float detectionLevel, Detector& detector)
+    {
         // Frequency-dependent detection (T4 cell is more sensitive to midrange)
         // Simple high-frequency rolloff to simulate T4 response
         float hfRolloff = 0.7f; // Reduces high frequency sensitivity
@@ -318,7 +1054,7 @@ public:
             // Feedback topology creates variable ratio
             // Starts gentle and increases with level
             float variableRatio = 1.0f + excess * 20.0f;
-            if (limitMode)
+            if constexpr (LimitMode)
                 variableRatio *= 10.0f; // Much higher ratios in limit mode
             
             // Calculate gain reduction in dB
@@ -338,9 +1074,7 @@ public:
         
         if (targetGain < detector.envelope)
         {
-            // Attack phase - 10ms average - calculate coefficient properly for actual sample rate
-            float attackTime = Constants::OPTO_ATTACK_TIME;
-            float attackCoeff = std::exp(-1.0f / (juce::jmax(Constants::EPSILON, attackTime * static_cast<float>(sampleRate))));
+            // Attack phase - 10ms average - coefficient cached for the actual sample rate
             detector.envelope = targetGain + (detector.envelope - targetGain) * attackCoeff;
             
             // Reset release tracking
@@ -379,7 +1113,8 @@ public:
                 detector.releasePhase = 2;
             }
             
-            float releaseCoeff = std::exp(-1.0f / (juce::jmax(Constants::EPSILON, releaseTime * static_cast<float>(sampleRate))));
+            // Release time is program dependent - use the table instead of std::exp
+            float releaseCoeff = lookupTables.envelopeCoefficient(releaseTime, sampleRateFloat);
             detector.envelope = targetGain + (detector.envelope - targetGain) * releaseCoeff;
             
             // NaN/Inf safety check
@@ -401,28 +1136,32 @@ public:
             detector.maxReduction *= 0.9999f;
             detector.holdCounter *= 0.999f;
         }
-        
+    }
+    
+    // Tube output stage and transformer for one compressed sample
+    template <bool Oversample>
+    SampleType processOutputStage(SampleType compressed, OutputStage& output, const BlockState& state)
+    {
         // LA-2A Tube output stage - 12AX7 tube followed by 12AQ5 power tube
         // The LA-2A has a characteristic warm tube sound with prominent 2nd harmonic
-        float makeupGain = juce::Decibels::decibelsToGain(gain);
-        float driven = compressed * makeupGain;
+        SampleType driven = compressed * state.makeupGain;
         
         // LA-2A tube harmonics - generate based on whether oversampling is active
-        // When oversampling is ON, we're at 2x rate so harmonics won't alias
+        // When oversampling is ON, the tube stage runs above the host rate so harmonics won't alias
         // When oversampling is OFF, we limit harmonics to prevent aliasing
         
-        float saturated = driven;
-        float absInput = std::abs(driven);
+        SampleType saturated = driven;
+        SampleType absInput = std::abs(driven);
         
         if (absInput > 0.001f)  // Lower threshold for harmonic generation
         {
-            float sign = (driven < 0.0f) ? -1.0f : 1.0f;
-            float levelDb = juce::Decibels::gainToDecibels(juce::jmax(0.0001f, absInput));
+            SampleType sign = (driven < 0.0f) ? -1.0f : 1.0f;
+            float levelDb = juce::Decibels::gainToDecibels(juce::jmax(0.0001f, static_cast<float>(absInput)));
             
             // Calculate harmonic levels
-            float h2_level = 0.0f;
-            float h3_level = 0.0f;
-            float h4_level = 0.0f;
+            SampleType h2_level = 0.0f;
+            SampleType h3_level = 0.0f;
+            SampleType h4_level = 0.0f;
             
             // LA-2A has more harmonic content than 1176
             if (levelDb > -40.0f)  // Add harmonics above -40dB
@@ -438,7 +1177,7 @@ public:
                 
                 // 4th harmonic - minimal in LA-2A
                 // Only add if we're oversampling (to prevent aliasing)
-                if (oversample)
+                if constexpr (Oversample)
                 {
                     float h4_scale = thd_target * 0.03f;
                     h4_level = absInput * absInput * absInput * absInput * h4_scale;
@@ -451,29 +1190,29 @@ public:
             // Add 2nd harmonic (even) - main tube warmth
             if (h2_level > 0.0f)
             {
-                float squared = driven * driven * sign;
+                SampleType squared = driven * driven * sign;
                 saturated += squared * h2_level;
             }
             
             // Add 3rd harmonic (odd) - subtle tube character
             if (h3_level > 0.0f)
             {
-                float cubed = driven * driven * driven;
+                SampleType cubed = driven * driven * driven;
                 saturated += cubed * h3_level;
             }
             
             // Add 4th harmonic (even) - extra warmth (only if oversampled)
             if (h4_level > 0.0f)
             {
-                float pow4 = driven * driven * driven * driven * sign;
+                SampleType pow4 = driven * driven * driven * driven * sign;
                 saturated += pow4 * h4_level;
             }
             
             // Soft saturation for tube compression at high levels
             if (absInput > 0.8f)
             {
-                float excess = (absInput - 0.8f) / 0.2f;
-                float tubeSat = 0.8f + 0.2f * std::tanh(excess * 0.7f);
+                SampleType excess = (absInput - 0.8f) / 0.2f;
+                SampleType tubeSat = 0.8f + 0.2f * std::tanh(excess * 0.7f);
                 saturated = sign * tubeSat * (saturated / absInput);
             }
         }
@@ -481,112 +1220,309 @@ public:
         // LA-2A output transformer - gentle high-frequency rolloff
         // Characteristic warmth from transformer
         // Use fixed filtering regardless of oversampling to maintain consistent harmonics
-        float transformerFreq = 20000.0f;  // Fixed frequency for consistent harmonics
-        // Always use base sample rate for consistent filtering
-        float filterCoeff = std::exp(-2.0f * 3.14159f * transformerFreq / static_cast<float>(sampleRate));
+        // Fixed 20kHz at the saturation rate - coefficient cached in updateCoefficients()
+        const float filterCoeff = transformerCoeff;
         
         // Check for NaN/Inf and reset if needed
-        if (std::isnan(detector.saturationLowpass) || std::isinf(detector.saturationLowpass))
-            detector.saturationLowpass = 0.0f;
+        if (std::isnan(output.saturationLowpass) || std::isinf(output.saturationLowpass))
+            output.saturationLowpass = 0.0f;
             
-        detector.saturationLowpass = saturated * (1.0f - filterCoeff * 0.05f) + detector.saturationLowpass * filterCoeff * 0.05f;
+        output.saturationLowpass = saturated * (1.0f - filterCoeff * 0.05f) + output.saturationLowpass * filterCoeff * 0.05f;
         
-        return juce::jlimit(-Constants::OUTPUT_HARD_LIMIT, Constants::OUTPUT_HARD_LIMIT, detector.saturationLowpass);
+        return limitOutput(output.saturationLowpass);
     }
     
-    float getGainReduction(int channel) const
+    // Sample-rate dependent coefficients, recomputed only from prepare()
+    void updateCoefficients()
     {
-        if (channel >= static_cast<int>(detectors.size()))
-            return 0.0f;
-        return juce::Decibels::gainToDecibels(detectors[channel].envelope);
+        if (sampleRate <= 0.0)
+            return;
+        
+        sampleRateFloat = static_cast<float>(sampleRate);
+        attackCoeff = std::exp(-1.0f / (juce::jmax(Constants::EPSILON, Constants::OPTO_ATTACK_TIME * sampleRateFloat)));
+        transformerCoeff = std::exp(-2.0f * 3.14159f * 20000.0f / (sampleRateFloat * static_cast<float>(saturationFactor)));
     }
-
-private:
-    struct Detector
-    {
-        float envelope = 1.0f;
-        float rms = 0.0f;
-        float releaseStartLevel = 1.0f;  // For two-stage release
-        int releasePhase = 0;             // 0=idle, 1=fast, 2=slow
-        float maxReduction = 0.0f;       // Track max reduction for program dependency
-        float holdCounter = 0.0f;        // Track how long compression is held
-        float lightMemory = 0.0f;        // T4 cell light memory
-        float previousReduction = 0.0f;  // Previous reduction for delta tracking
-        float hfFilter = 0.0f;           // High frequency filter state
-        float releaseStartTime = 0.0f;   // Time since release started
-        float saturationLowpass = 0.0f;  // Anti-aliasing filter state
-        float prevInput = 0.0f;          // Previous input for filtering
-    };
     
+    const LookupTables& lookupTables;
     std::vector<Detector> detectors;
+    std::vector<OutputStage> outputStages;
+    std::vector<float> linkLevels;   // Stereo link scratch, one level per channel
+    BlockState blockState;           // Invariants of the block being processed
     double sampleRate = 0.0;  // Set by prepare() from DAW
-    
-    // PROFESSIONAL FIX: Dedicated oversampler for saturation stage
-    // This ALWAYS runs at 2x to ensure consistent harmonics
-    std::unique_ptr<juce::dsp::Oversampling<float>> saturationOversampler;
+    float sampleRateFloat = 0.0f;
+    int saturationFactor = 1;        // Oversampling of the tube stage
+    float attackCoeff = 0.0f;        // T4 cell attack (fixed 10ms)
+    float transformerCoeff = 0.0f;   // Output transformer lowpass
 };
 
 // FET Compressor (1176 style)
+// Audio path runs in SampleType, detection and gain computer in float
+template <typename SampleType>
 class UniversalCompressor::FETCompressor
 {
 public:
-    void prepare(double sampleRate, int numChannels)
+    explicit FETCompressor(const LookupTables& tables) : lookupTables(tables) {}
+    
+    // The gain computer runs at the host rate, the amplifier stage at saturationFactor times it
+    void prepare(double sampleRate, int numChannels, int maxBlockSize, int saturationFactor)
     {
         this->sampleRate = sampleRate;
+        this->saturationFactor = juce::jmax(1, saturationFactor);
+        updateCoefficients();
         detectors.resize(numChannels);
         for (auto& detector : detectors)
         {
             detector.envelope = 1.0f;
-            detector.prevOutput = 0.0f;
             detector.previousLevel = 0.0f;
         }
+        outputStages.assign(static_cast<size_t>(numChannels), OutputStage{});
+        linkLevels.assign(static_cast<size_t>(numChannels), 0.0f);
+        reductions.setSize(juce::jmax(1, numChannels), juce::jmax(1, maxBlockSize));
+        reductions.clear();
     }
     
-    float process(float input, int channel, float inputGainDb, float outputGainDb, 
-                  float attackMs, float releaseMs, int ratioIndex, bool oversample = false)
+    // Block-rate parameters, read once per processBlock call
+    struct Params
     {
-        if (channel >= static_cast<int>(detectors.size()))
-            return input;
+        float inputGainDb = 0.0f;    // Input knob (-20 to +40dB)
+        float outputGainDb = 0.0f;   // Output knob (-20 to +20dB)
+        float attackMs = 0.02f;      // 0.02 to 0.8ms
+        float releaseMs = 400.0f;    // 50 to 1100ms
+        int ratioIndex = 0;          // 4:1, 8:1, 12:1, 20:1, All
+        float stereoLink = 0.0f;     // 0-1, pull toward the loudest channel
+        const LinkGroups* linkGroups = nullptr;  // Channels linked together, nullptr = all of them
+    };
+    
+    // Input stage, detection and gain computer at the host rate. Leaves the compressed
+    // signal in channelData and the per-sample reduction for processSaturation.
+    // keyData holds one detector key per channel, or nullptr to key each channel from itself
+    void processBlock(SampleType* const* channelData, const SampleType* const* keyData,
+                      int numChannels, int numSamples, const Params& params)
+    {
+        if (channelData == nullptr)
+            return;
+        if (keyData == nullptr)
+            keyData = channelData;
         
         // Safety check for sample rate
         if (sampleRate <= 0.0)
-            return input;
+            return;
+        jassert(numSamples <= reductions.getNumSamples());  // The processor splits blocks to the prepared size
+        
+        // Feedback detection, as in the Opto, so profiled with the gain stage
+        UNIVERSAL_COMPRESSOR_STAGE_TIMER(GainEnvelope, numSamples)
+        
+        // Derive gains, threshold and ratio once for the whole block.
+        // The state is kept for the saturation pass over the same block
+        BlockState& state = blockState;
+        state = BlockState{};
+        state.attackMs = params.attackMs;
+        state.releaseMs = params.releaseMs;
+        
+        // Fixed threshold (1176 characteristic)
+        // The 1176 threshold is around -10 dBFS according to specifications
+        // This is the level where compression begins to engage
+        state.threshold = juce::Decibels::decibelsToGain(Constants::FET_THRESHOLD_DB);
+        
+        // Input knob range: -20 to +40dB
+        state.inputGainLin = juce::Decibels::decibelsToGain(params.inputGainDb);
+        
+        // Output parameter is in dB (-20 to +20dB) - pure makeup gain after compression
+        state.outputGainLin = juce::Decibels::decibelsToGain(params.outputGainDb);
+        
+        // Ratio mapping: 4:1, 8:1, 12:1, 20:1, all-buttons mode
+        static constexpr std::array<float, 5> ratios = {4.0f, 8.0f, 12.0f, 20.0f, 100.0f}; // All-buttons is near-limiting
+        state.ratio = ratios[static_cast<size_t>(juce::jlimit(0, 4, params.ratioIndex))];
+        
+        const int channelsToProcess = juce::jmin(numChannels, static_cast<int>(detectors.size()));
+        const LinkGroups linkGroups = LinkGroups::forChannels(params.linkGroups, channelsToProcess);
+        state.link = linkGroups.linksAnyChannels() ? juce::jlimit(0.0f, 1.0f, params.stereoLink) : 0.0f;
+        const bool allButtons = params.ratioIndex == 4;
+        
+        // Feedback detection depends on the output, so linked channels have to advance
+        // together sample by sample. Each link group is linked on its own
+        if (state.link > 0.0f)
+        {
+            const bool fullLink = state.link >= Constants::FULL_STEREO_LINK;
+            const auto kernel = allButtons ? (fullLink ? &FETCompressor::processLinked<true, true>
+                                                       : &FETCompressor::processLinked<true, false>)
+                                           : (fullLink ? &FETCompressor::processLinked<false, true>
+                                                       : &FETCompressor::processLinked<false, false>);
+            for (int group = 0; group < linkGroups.getNumGroups(); ++group)
+                (this->*kernel)(channelData, keyData, linkGroups.getFirstChannel(group), linkGroups.getNumChannels(group),
+                                numSamples, state);
+            return;
+        }
+        
+        // All-buttons mode selects a specialised kernel once per block
+        const auto kernel = allButtons ? &FETCompressor::processChannel<true>
+                                       : &FETCompressor::processChannel<false>;
+        
+        // Unlinked, each channel's detection depends only on its own output, so channels run one after another
+        for (int channel = 0; channel < channelsToProcess; ++channel)
+            (this->*kernel)(channelData[channel], keyData[channel], reductions.getWritePointer(channel), numSamples,
+                            detectors[static_cast<size_t>(channel)], state);
+    }
+    
+    // FET amplifier and transformer over the block processBlock just compressed, run at
+    // the saturation rate - numSamples is the host block times the saturation factor.
+    // Each host-rate reduction value is held across its oversampled frame
+    void processSaturation(SampleType* const* channelData, int numChannels, int numSamples)
+    {
+        if (channelData == nullptr || sampleRate <= 0.0)
+            return;
+        
+        const int channelsToProcess = juce::jmin(numChannels, static_cast<int>(outputStages.size()));
+        const int numFrames = juce::jmin(numSamples / saturationFactor, reductions.getNumSamples());
+        for (int channel = 0; channel < channelsToProcess; ++channel)
+        {
+            SampleType* data = channelData[channel];
+            const float* reduction = reductions.getReadPointer(channel);
+            auto& outputStage = outputStages[static_cast<size_t>(channel)];
             
-        auto& detector = detectors[channel];
+            for (int frame = 0, i = 0; frame < numFrames; ++frame)
+                for (int k = 0; k < saturationFactor; ++k, ++i)
+                    data[i] = processOutputStage(data[i], reduction[frame], outputStage, blockState);
+        }
+    }
+    
+    float getGainReduction(int channel) const
+    {
+        if (channel >= static_cast<int>(detectors.size()))
+            return 0.0f;
+        return juce::Decibels::gainToDecibels(detectors[channel].envelope);
+    }
+
+private:
+    struct Detector
+    {
+        float envelope = 1.0f;
+        float previousLevel = 0.0f; // For program-dependent behavior
+    };
+    
+    // Per-channel output transformer state, separate from the detector so
+    // linked channels can share one gain computer
+    struct OutputStage
+    {
+        SampleType prevOutput = 0;
+    };
+    
+    // Per-block invariants derived from Params
+    struct BlockState
+    {
+        float threshold = 1.0f;
+        float inputGainLin = 1.0f;
+        float outputGainLin = 1.0f;
+        float ratio = 4.0f;
+        float attackMs = 0.02f;
+        float releaseMs = 400.0f;
+        float link = 0.0f;          // Stereo link, 0 when channels run independently
+    };
+    
+    // Sample loop specialised on all-buttons mode, so the inner loop has no mode branches
+    template <bool AllButtons>
+    void processChannel(SampleType* data, const SampleType* key, float* reduction, int numSamples,
+                        Detector& detector, const BlockState& state)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            SampleType compressed = driveInput(data[i], detector.envelope, state);
+            reduction[i] = updateGain<AllButtons>(detect(key[i], detector, state), detector, state);
+            data[i] = compressed;
+        }
+    }
+    
+    // Linked channels firstChannel onwards, advanced together one sample at a time. Fully
+    // linked, the group's first gain computer sees the loudest channel and its gain drives
+    // every channel. Partially linked, each channel sees its own level pulled toward the loudest one
+    template <bool AllButtons, bool FullLink>
+    void processLinked(SampleType* const* channelData, const SampleType* const* keyData,
+                       int firstChannel, int numChannels, int numSamples, const BlockState& state)
+    {
+        const int lastChannel = firstChannel + numChannels;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if constexpr (FullLink)
+            {
+                auto& detector = detectors[static_cast<size_t>(firstChannel)];
+                float loudest = 0.0f;
+                for (int channel = firstChannel; channel < lastChannel; ++channel)
+                    loudest = juce::jmax(loudest, detect(keyData[channel][i], detector, state));
+                
+                // Gain is applied before the envelope updates, as in the per-channel loop
+                const float gain = detector.envelope;
+                const float reduction = updateGain<AllButtons>(loudest, detector, state);
+                
+                for (int channel = firstChannel; channel < lastChannel; ++channel)
+                {
+                    channelData[channel][i] = driveInput(channelData[channel][i], gain, state);
+                    reductions.getWritePointer(channel)[i] = reduction;
+                }
+            }
+            else
+            {
+                float loudest = 0.0f;
+                for (int channel = firstChannel; channel < lastChannel; ++channel)
+                {
+                    const auto index = static_cast<size_t>(channel);
+                    linkLevels[index] = detect(keyData[channel][i], detectors[index], state);
+                    loudest = juce::jmax(loudest, linkLevels[index]);
+                }
+                
+                for (int channel = firstChannel; channel < lastChannel; ++channel)
+                {
+                    const auto index = static_cast<size_t>(channel);
+                    auto& detector = detectors[index];
+                    SampleType compressed = driveInput(channelData[channel][i], detector.envelope, state);
+                    reductions.getWritePointer(channel)[i] = updateGain<AllButtons>(linkLevels[index] + (loudest - linkLevels[index]) * state.link,
+                                                                                    detector, state);
+                    channelData[channel][i] = compressed;
+                }
+            }
+        }
         
+        // Fully linked channels share the group's first gain computer, keep the rest in step for metering
+        if constexpr (FullLink)
+            std::fill(detectors.begin() + firstChannel + 1, detectors.begin() + lastChannel, detectors[static_cast<size_t>(firstChannel)]);
+    }
+    
+    // Input stage: input knob gain, then the gain cell with the previous envelope
+    SampleType driveInput(SampleType input, float envelope, const BlockState& state) const
+    {
         // 1176 Input transformer emulation
         // The 1176 uses the full input signal, not highpass filtered
         // The transformer provides some low-frequency coupling but doesn't remove DC entirely
-        float filteredInput = input;
+        SampleType filteredInput = input;
         
         // 1176 Input control - AUTHENTIC BEHAVIOR
         // The 1176 has a FIXED threshold that the input knob drives signal into
         // More input = more compression (not threshold change)
         
-        // Fixed threshold (1176 characteristic)
-        // The 1176 threshold is around -10 dBFS according to specifications
-        // This is the level where compression begins to engage
-        const float thresholdDb = Constants::FET_THRESHOLD_DB; // Authentic 1176 threshold
-        float threshold = juce::Decibels::decibelsToGain(thresholdDb);
-        
         // Apply FULL input gain - this is how you drive into compression
-        // Input knob range: -20 to +40dB
-        float inputGainLin = juce::Decibels::decibelsToGain(inputGainDb);
-        float amplifiedInput = filteredInput * inputGainLin;
-        
-        // Ratio mapping: 4:1, 8:1, 12:1, 20:1, all-buttons mode
-        std::array<float, 5> ratios = {4.0f, 8.0f, 12.0f, 20.0f, 100.0f}; // All-buttons is near-limiting
-        float ratio = ratios[juce::jlimit(0, 4, ratioIndex)];
+        SampleType amplifiedInput = filteredInput * state.inputGainLin;
         
         // FEEDBACK TOPOLOGY for authentic 1176 behavior
         // The 1176 uses feedback compression which creates its characteristic sound
         
         // First, we need to apply the PREVIOUS envelope to get the compressed signal
-        float compressed = amplifiedInput * detector.envelope;
-        
-        // Then detect from the COMPRESSED OUTPUT (feedback)
-        // This is what gives the 1176 its "grabby" characteristic
-        float detectionLevel = std::abs(compressed);
+        return amplifiedInput * envelope;
+    }
+    
+    // Then detect from the COMPRESSED OUTPUT (feedback)
+    // This is what gives the 1176 its "grabby" characteristic
+    // An external key is driven through the same input gain and gain cell
+    float detect(SampleType key, const Detector& detector, const BlockState& state) const
+    {
+        return static_cast<float>(std::abs(key * state.inputGainLin * detector.envelope));
+    }
+    
+    // Gain computer: curve, program-dependent timing and envelope for one sample.
+    // Returns the gain reduction in dB, which also drives the output harmonics
+    template <bool AllButtons>
+    float updateGain(float detectionLevel, Detector& detector, const BlockState& state)
+    {
+        const float threshold = state.threshold;
+        const float ratio = state.ratio;
         
         // Calculate gain reduction based on how much we exceed threshold
         float reduction = 0.0f;
@@ -596,7 +1532,7 @@ public:
             float overThreshDb = juce::Decibels::gainToDecibels(detectionLevel / threshold);
             
             // Classic 1176 compression curve
-            if (ratioIndex == 4) // All-buttons mode (FET mode)
+            if constexpr (AllButtons) // All-buttons mode (FET mode)
             {
                 // All-buttons mode creates a unique compression characteristic
                 // The actual 1176 in all-buttons mode creates a gentler slope at low levels
@@ -636,11 +1572,11 @@ public:
         // Release parameter is already in ms (50 to 1100ms)
         // Per the manual: Attack < 20 microseconds to 800 microseconds
         // Release: 50ms to 1.1 seconds
-        float attackTime = attackMs * 0.001f; // Convert ms to seconds
-        float releaseTime = releaseMs * 0.001f;  // Convert ms to seconds
+        float attackTime = state.attackMs * 0.001f; // Convert ms to seconds
+        float releaseTime = state.releaseMs * 0.001f;  // Convert ms to seconds
         
         // All-buttons mode (FET mode) affects timing
-        if (ratioIndex == 4)
+        if constexpr (AllButtons)
         {
             // All-buttons mode has fast attack and modified release
             // But not so fast that it causes distortion
@@ -674,27 +1610,24 @@ public:
         // Envelope following with proper exponential coefficients
         float targetGain = juce::Decibels::decibelsToGain(-reduction);
         
-        // Calculate proper exponential coefficients for smooth envelope with safety checks
-        float attackCoeff = std::exp(-1.0f / (juce::jmax(Constants::EPSILON, attackTime * static_cast<float>(sampleRate))));
-        float releaseCoeff = std::exp(-1.0f / (juce::jmax(Constants::EPSILON, releaseTime * static_cast<float>(sampleRate))));
-        
+        // Attack/release times are program dependent, so coefficients come from the
+        // exp table and only the one needed for the current phase is evaluated
         
         // FET mode has unique envelope behavior
-        if (ratioIndex == 4)
+        if constexpr (AllButtons)
         {
             // All-buttons mode has faster but still controlled envelope following
             // This creates the characteristic "pumping" effect without instability
             if (targetGain < detector.envelope)
             {
                 // Fast attack in FET mode but not instantaneous to avoid distortion
-                float fetAttackCoeff = std::exp(-1.0f / (Constants::FET_ALLBUTTONS_ATTACK * static_cast<float>(sampleRate)));
-                detector.envelope = fetAttackCoeff * detector.envelope + (1.0f - fetAttackCoeff) * targetGain;
+                detector.envelope = allButtonsAttackCoeff * detector.envelope + (1.0f - allButtonsAttackCoeff) * targetGain;
             }
             else
             {
                 // Release with characteristic FET mode "breathing"
                 // Slightly faster release but still smooth
-                float fetReleaseCoeff = releaseCoeff * 0.98f; // Slightly faster than normal
+                float fetReleaseCoeff = lookupTables.envelopeCoefficient(releaseTime, sampleRateFloat) * 0.98f; // Slightly faster than normal
                 detector.envelope = fetReleaseCoeff * detector.envelope + (1.0f - fetReleaseCoeff) * targetGain;
             }
         }
@@ -704,11 +1637,13 @@ public:
             if (targetGain < detector.envelope)
             {
                 // Attack phase - FET response
+                float attackCoeff = lookupTables.envelopeCoefficient(attackTime, sampleRateFloat);
                 detector.envelope = attackCoeff * detector.envelope + (1.0f - attackCoeff) * targetGain;
             }
             else
             {
                 // Release phase
+                float releaseCoeff = lookupTables.envelopeCoefficient(releaseTime, sampleRateFloat);
                 detector.envelope = releaseCoeff * detector.envelope + (1.0f - releaseCoeff) * targetGain;
             }
         }
@@ -721,20 +1656,26 @@ public:
         if (std::isnan(detector.envelope) || std::isinf(detector.envelope))
             detector.envelope = 1.0f;
         
+        return reduction;
+    }
+    
+    // Output stage: FET amplifier harmonics, transformer and output knob
+    SampleType processOutputStage(SampleType compressed, float reduction, OutputStage& outputStage, const BlockState& state) const
+    {
         // 1176 Class A FET amplifier stage
         // The 1176 is VERY clean at -18dB input level
         // UAD reference shows THD at -65dB with 2nd harmonic at -100dB
         // Apply the envelope to get the output signal
-        float output = compressed;
+        SampleType output = compressed;
         
         // The 1176 is an extremely clean compressor with minimal harmonics
         // At -18dB input: 2nd harmonic at -100dB, 3rd at -110dB
-        float absOutput = std::abs(output);
+        SampleType absOutput = std::abs(output);
         
         // Very subtle FET harmonics - only when compressing
         if (reduction > 3.0f && absOutput > 0.001f)
         {
-            float sign = (output < 0.0f) ? -1.0f : 1.0f;
+            SampleType sign = (output < 0.0f) ? -1.0f : 1.0f;
             
             // No pre-saturation compensation needed anymore
             // We apply compensation AFTER saturation to avoid compression effects
@@ -750,120 +1691,367 @@ public:
             // At -18dB with compression, target -100dB (0.00001 linear)
             // Scale = 0.00001 / (0.126²) = 0.00063
             float h2_scale = 0.00063f;  // Produces -100dB at -18dB input
-            float h2 = output * output * h2_scale * compressionScale * h2Boost;
+            SampleType h2 = output * output * h2_scale * compressionScale * h2Boost;
             
             // 3rd harmonic: -110dB absolute (-92dB relative at -18dB)  
             // At -18dB with compression, target -110dB (0.00000316 linear)
             // Adjusted to match 1176 hardware (very clean)
             float h3_scale = 0.0005f;  // Produces -110dB at -18dB input
-            float h3 = output * output * output * h3_scale * compressionScale * h3Boost;
+            SampleType h3 = output * output * output * h3_scale * compressionScale * h3Boost;
+            
+            output += h2 * sign + h3;
+        }
+        
+        // Hard limiting if we're clipping
+        if (absOutput > 1.5f)
+        {
+            SampleType sign = (output < 0.0f) ? -1.0f : 1.0f;
+            output = sign * (1.5f + std::tanh((absOutput - 1.5f) * 0.2f) * 0.5f);
+        }
+        
+        // Harmonic compensation removed - was causing artifacts
+        
+        // Output transformer simulation - very subtle
+        // 1176 has minimal transformer coloration
+        // Just a gentle rolloff above 20kHz for anti-aliasing
+        // Use fixed filtering regardless of oversampling to maintain consistent harmonics
+        // Fixed 20kHz at the saturation rate - coefficient cached in updateCoefficients()
+        SampleType filtered = output * (1.0f - transformerCoeff * 0.05f) + outputStage.prevOutput * transformerCoeff * 0.05f;
+        outputStage.prevOutput = filtered;
+        
+        // 1176 Output knob - makeup gain control
+        SampleType finalOutput = filtered * state.outputGainLin;
+        
+        // Ensure output is within reasonable bounds
+        return limitOutput(finalOutput);
+    }
+    
+    // Sample-rate dependent coefficients, recomputed only from prepare()
+    void updateCoefficients()
+    {
+        if (sampleRate <= 0.0)
+            return;
+        
+        sampleRateFloat = static_cast<float>(sampleRate);
+        allButtonsAttackCoeff = std::exp(-1.0f / (Constants::FET_ALLBUTTONS_ATTACK * sampleRateFloat));
+        transformerCoeff = std::exp(-2.0f * 3.14159f * 20000.0f / (sampleRateFloat * static_cast<float>(saturationFactor)));
+    }
+    
+    const LookupTables& lookupTables;
+    std::vector<Detector> detectors;
+    std::vector<OutputStage> outputStages;
+    std::vector<float> linkLevels;   // Stereo link scratch, one level per channel
+    juce::AudioBuffer<float> reductions;  // Host-rate gain reduction (dB) handed to the output stage
+    BlockState blockState;           // Invariants of the block being processed
+    double sampleRate = 0.0;  // Set by prepare() from DAW
+    float sampleRateFloat = 0.0f;
+    int saturationFactor = 1;        // Oversampling of the amplifier stage
+    float allButtonsAttackCoeff = 0.0f;  // Fixed 100us attack in all-buttons mode
+    float transformerCoeff = 0.0f;       // Output transformer lowpass
+};
+
+// VCA Compressor (DBX 160 style)
+// Audio path runs in SampleType, detection and gain computer in float
+template <typename SampleType>
+class UniversalCompressor::VCACompressor
+{
+public:
+    explicit VCACompressor(const LookupTables& tables) : lookupTables(tables) {}
+    
+    // The gain computer runs at the host rate, the VCA colouration at saturationFactor times it
+    void prepare(double sampleRate, int numChannels, int maxBlockSize, int saturationFactor)
+    {
+        this->sampleRate = sampleRate;
+        this->numChannels = juce::jmax(0, numChannels);
+        this->saturationFactor = juce::jmax(1, saturationFactor);
+        updateCoefficients();
+        detectorGroups.assign(getNumDetectorGroups(numChannels), DetectorGroup{});
+        frames.resize(detectorGroups.size());
+        for (auto& groupFrames : frames)
+            groupFrames.prepare(maxBlockSize);
+        loudestLevels.assign(static_cast<size_t>(juce::jmax(1, maxBlockSize) * juce::jmax(1, numChannels)), 0.0f);
+        reductions.setSize(juce::jmax(1, numChannels), juce::jmax(1, maxBlockSize));
+        reductions.clear();
+    }
+    
+    // Block-rate parameters, read once per processBlock call
+    struct Params
+    {
+        float threshold = 0.0f;      // dB (-38 to +12)
+        float ratio = 2.0f;          // 1:1 to 120:1
+        float attack = 1.0f;         // ms - DBX 160 attack is program dependent
+        float release = 100.0f;      // ms - DBX 160 release is a fixed 120dB/s
+        float outputGain = 0.0f;     // dB
+        bool overEasy = false;
+        float stereoLink = 0.0f;     // 0-1, pull toward the loudest channel
+        const LinkGroups* linkGroups = nullptr;  // Channels linked together, nullptr = all of them
+    };
+    
+    // Detection and gain computer at the host rate. Leaves the gain-reduced signal in
+    // channelData and the per-sample reduction for processSaturation.
+    // keyData holds one detector key per channel, or nullptr to key each channel from itself
+    void processBlock(SampleType* const* channelData, const SampleType* const* keyData,
+                      int numChannels, int numSamples, const Params& params)
+    {
+        if (channelData == nullptr)
+            return;
+        if (keyData == nullptr)
+            keyData = channelData;
+        
+        // Safety check for sample rate
+        if (sampleRate <= 0.0)
+            return;
+        jassert(numSamples <= reductions.getNumSamples());  // The processor splits blocks to the prepared size
+        
+        const int channelsToProcess = juce::jmin(numChannels, this->numChannels);
+        
+        // Derive threshold, slope and output gain once for the whole block.
+        // The state is kept for the saturation pass over the same block
+        BlockState& state = blockState;
+        state = BlockState{};
+        state.thresholdLin = juce::Decibels::decibelsToGain(params.threshold);
+        state.slope = 1.0f - 1.0f / params.ratio;
+        state.outputGainLin = juce::Decibels::decibelsToGain(params.outputGain);
+        const LinkGroups linkGroups = LinkGroups::forChannels(params.linkGroups, channelsToProcess);
+        const int numLinkGroups = linkGroups.getNumGroups();
+        state.link = linkGroups.linksAnyChannels() ? juce::jlimit(0.0f, 1.0f, params.stereoLink) : 0.0f;
+        
+        // OverEasy selects a specialised gain stage once per block
+        const auto kernel = params.overEasy ? &VCACompressor::processChannel<true>
+                                            : &VCACompressor::processChannel<false>;
+        const auto linkedKernel = params.overEasy ? &VCACompressor::processLinked<true>
+                                                  : &VCACompressor::processLinked<false>;
+        
+        // Feed-forward detection only sees the input, so every lane group runs the SIMD
+        // detector over the chunk first and the per-channel gain stage reads its result
+        const int numGroups = static_cast<int>(getNumDetectorGroups(channelsToProcess));
+        const int capacity = frames.front().getCapacity();
+        const bool fullyLinked = state.link >= Constants::FULL_STEREO_LINK;
+        for (int start = 0; start < numSamples; start += capacity)
+        {
+            const int chunkSize = juce::jmin(capacity, numSamples - start);
+            {
+                UNIVERSAL_COMPRESSOR_STAGE_TIMER(Detector, chunkSize)
+                for (int group = 0; group < numGroups; ++group)
+                {
+                    const int firstChannel = group * DETECTOR_LANES;
+                    const int groupChannels = juce::jmin(DETECTOR_LANES, channelsToProcess - firstChannel);
+                    auto& groupFrames = frames[static_cast<size_t>(group)];
+                    
+                    groupFrames.load(keyData + firstChannel, groupChannels, start, chunkSize);
+                    runDetector(detectorGroups[static_cast<size_t>(group)], groupFrames, chunkSize);
+                }
+                
+                // Each link group is linked on its own
+                if (state.link > 0.0f)
+                {
+                    for (int linkGroup = 0; linkGroup < numLinkGroups; ++linkGroup)
+                    {
+                        findLoudestLevels(frames, linkGroups.getFirstChannel(linkGroup), linkGroups.getNumChannels(linkGroup),
+                                          chunkSize, loudestLevels.data() + linkGroup * capacity);
+                    }
+                    
+                    if (!fullyLinked)
+                    {
+                        for (int group = 0; group < numGroups; ++group)
+                            blendTowardLoudest(frames[static_cast<size_t>(group)], group * DETECTOR_LANES, loudestLevels.data(), capacity,
+                                               linkGroups, chunkSize, state.link);
+                    }
+                }
+            }
+            
+            UNIVERSAL_COMPRESSOR_STAGE_TIMER(GainEnvelope, chunkSize)
+            
+            // Fully linked, one gain computer drives every channel of a group
+            if (fullyLinked)
+            {
+                for (int linkGroup = 0; linkGroup < numLinkGroups; ++linkGroup)
+                {
+                    (this->*linkedKernel)(channelData, linkGroups.getFirstChannel(linkGroup), linkGroups.getNumChannels(linkGroup),
+                                          start, chunkSize, loudestLevels.data() + linkGroup * capacity, state);
+                }
+                continue;
+            }
             
-            output += h2 * sign + h3;
+            for (int channel = 0; channel < channelsToProcess; ++channel)
+            {
+                const auto group = static_cast<size_t>(channel / DETECTOR_LANES);
+                (this->*kernel)(channelData[channel] + start, reductions.getWritePointer(channel, start), chunkSize,
+                                detectorGroups[group], frames[group], channel % DETECTOR_LANES, state);
+            }
         }
+    }
+    
+    // VCA colouration and output gain over the block processBlock just gain-reduced, run
+    // at the saturation rate - numSamples is the host block times the saturation factor.
+    // Each host-rate reduction value is held across its oversampled frame
+    void processSaturation(SampleType* const* channelData, int numChannels, int numSamples)
+    {
+        if (channelData == nullptr || sampleRate <= 0.0)
+            return;
         
-        // Hard limiting if we're clipping
-        if (absOutput > 1.5f)
+        const int channelsToProcess = juce::jmin(numChannels, this->numChannels);
+        const int numFrames = juce::jmin(numSamples / saturationFactor, reductions.getNumSamples());
+        for (int channel = 0; channel < channelsToProcess; ++channel)
         {
-            float sign = (output < 0.0f) ? -1.0f : 1.0f;
-            output = sign * (1.5f + std::tanh((absOutput - 1.5f) * 0.2f) * 0.5f);
+            SampleType* data = channelData[channel];
+            const float* reduction = reductions.getReadPointer(channel);
+            
+            for (int frame = 0, i = 0; frame < numFrames; ++frame)
+                for (int k = 0; k < saturationFactor; ++k, ++i)
+                    data[i] = processOutputStage(data[i], reduction[frame], blockState);
         }
-        
-        // Harmonic compensation removed - was causing artifacts
-        
-        // Output transformer simulation - very subtle
-        // 1176 has minimal transformer coloration
-        // Just a gentle rolloff above 20kHz for anti-aliasing
-        // Use fixed filtering regardless of oversampling to maintain consistent harmonics
-        float transformerFreq = 20000.0f;
-        // Always use base sample rate for consistent filtering
-        float transformerCoeff = std::exp(-2.0f * 3.14159f * transformerFreq / static_cast<float>(sampleRate));
-        float filtered = output * (1.0f - transformerCoeff * 0.05f) + detector.prevOutput * transformerCoeff * 0.05f;
-        detector.prevOutput = filtered;
-        
-        // 1176 Output knob - makeup gain control
-        // Output parameter is in dB (-20 to +20dB) - more reasonable range
-        // This is pure makeup gain after compression
-        float outputGainLin = juce::Decibels::decibelsToGain(outputGainDb);
-        
-        // Apply makeup gain
-        float finalOutput = filtered * outputGainLin;
-        
-        // Ensure output is within reasonable bounds
-        return juce::jlimit(-Constants::OUTPUT_HARD_LIMIT, Constants::OUTPUT_HARD_LIMIT, finalOutput);
     }
     
     float getGainReduction(int channel) const
     {
-        if (channel >= static_cast<int>(detectors.size()))
+        if (channel < 0 || channel >= numChannels)
             return 0.0f;
-        return juce::Decibels::gainToDecibels(detectors[channel].envelope);
+        const auto& group = detectorGroups[static_cast<size_t>(channel / DETECTOR_LANES)];
+        return juce::Decibels::gainToDecibels(group.envelope.get(static_cast<size_t>(channel % DETECTOR_LANES)));
     }
 
 private:
-    struct Detector
+    // Detector state in structure-of-arrays form, one lane per channel
+    struct DetectorGroup
+    {
+        DetectorLanes envelope = DetectorLanes::expand(1.0f);
+        DetectorLanes rmsBuffer = DetectorLanes::expand(0.0f);         // True RMS detection buffer
+        DetectorLanes previousReduction = DetectorLanes::expand(0.0f); // For program-dependent behavior
+        DetectorLanes controlVoltage = DetectorLanes::expand(0.0f);    // VCA control voltage (-6mV/dB)
+        DetectorLanes signalEnvelope = DetectorLanes::expand(0.0f);    // Signal envelope for program-dependent timing
+        DetectorLanes envelopeRate = DetectorLanes::expand(0.0f);      // Rate of envelope change
+        DetectorLanes previousInput = DetectorLanes::expand(0.0f);     // Previous input for envelope tracking
+    };
+    
+    // Scalar copy of one lane's gain-stage state, kept in registers for the sample loop
+    struct LaneState
     {
         float envelope = 1.0f;
-        float prevOutput = 0.0f;
-        float previousLevel = 0.0f; // For program-dependent behavior
+        float previousReduction = 0.0f;
+        float controlVoltage = 0.0f;
+        float signalEnvelope = 0.0f;
     };
     
-    std::vector<Detector> detectors;
-    double sampleRate = 0.0;  // Set by prepare() from DAW
-};
-
-// VCA Compressor (DBX 160 style)
-class UniversalCompressor::VCACompressor
-{
-public:
-    void prepare(double sampleRate, int numChannels)
+    // Per-block invariants derived from Params
+    struct BlockState
     {
-        this->sampleRate = sampleRate;
-        detectors.resize(numChannels);
-        for (auto& detector : detectors)
+        float thresholdLin = 1.0f;
+        float slope = 0.5f;              // 1 - 1/ratio
+        float outputGainLin = 1.0f;
+        float link = 0.0f;               // Stereo link, 0 when channels run independently
+    };
+    
+    // Gain computer output for one frame, consumed by the gain stage
+    struct Gain
+    {
+        float envelope = 1.0f;
+        float reduction = 0.0f;          // dB
+    };
+    
+    static LaneState loadLane(const DetectorGroup& group, size_t index)
+    {
+        LaneState detector;
+        detector.envelope = group.envelope.get(index);
+        detector.previousReduction = group.previousReduction.get(index);
+        detector.controlVoltage = group.controlVoltage.get(index);
+        detector.signalEnvelope = group.signalEnvelope.get(index);
+        return detector;
+    }
+    
+    static void storeLane(DetectorGroup& group, size_t index, const LaneState& detector)
+    {
+        group.envelope.set(index, detector.envelope);
+        group.previousReduction.set(index, detector.previousReduction);
+        group.controlVoltage.set(index, detector.controlVoltage);
+        group.signalEnvelope.set(index, detector.signalEnvelope);
+    }
+    
+    // SIMD detector kernel for one lane group, run in place over the frames.
+    // Leaves the true RMS mean square of every lane for the gain stage
+    void runDetector(DetectorGroup& group, DetectorFrames& groupFrames, int numSamples)
+    {
+        auto rmsBuffer = group.rmsBuffer;
+        auto envelopeRate = group.envelopeRate;
+        auto previousInput = group.previousInput;
+        
+        for (int i = 0; i < numSamples; ++i)
         {
-            detector.envelope = 1.0f;
-            detector.rmsBuffer = 0.0f;
-            detector.previousReduction = 0.0f;
-            detector.controlVoltage = 0.0f;
-            detector.signalEnvelope = 0.0f;
-            detector.envelopeRate = 0.0f;
-            detector.previousInput = 0.0f;
+            // DBX 160 feedforward topology: control voltage from input signal
+            const auto detectionLevel = DetectorLanes::abs(groupFrames[i]);
+            
+            // DBX 160 True RMS detection - closely simulates human ear response
+            // Uses proper RMS window suitable for program material
+            // 3ms RMS averaging for transient response - coefficient cached in updateCoefficients()
+            rmsBuffer = rmsBuffer * rmsAlpha + detectionLevel * detectionLevel * (1.0f - rmsAlpha);
+            
+            // Track signal envelope rate of change for program-dependent behavior
+            const auto signalDelta = DetectorLanes::abs(detectionLevel - previousInput);
+            envelopeRate = envelopeRate * 0.95f + signalDelta * 0.05f;
+            previousInput = detectionLevel;
+            
+            groupFrames[i] = rmsBuffer;
         }
+        
+        group.rmsBuffer = rmsBuffer;
+        group.envelopeRate = envelopeRate;
+        group.previousInput = previousInput;
     }
     
-    float process(float input, int channel, float threshold, float ratio, 
-                  float attackParam, float releaseParam, float outputGain, bool overEasy = false, bool oversample = false)
+    // Gain stage for one channel of a lane group, driven by the detector frames.
+    // Specialised on OverEasy so the inner loop has no knee-mode branch
+    template <bool OverEasy>
+    void processChannel(SampleType* data, float* reduction, int numSamples, DetectorGroup& group,
+                        const DetectorFrames& groupFrames, int lane, const BlockState& state)
     {
-        if (channel >= static_cast<int>(detectors.size()))
-            return input;
+        const auto index = static_cast<size_t>(lane);
+        LaneState detector = loadLane(group, index);
         
-        // Safety check for sample rate
-        if (sampleRate <= 0.0)
-            return input;
-            
-        auto& detector = detectors[channel];
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = applyGain(data[i], computeGain<OverEasy>(groupFrames.get(i, lane), detector, state), reduction[i]);
         
-        // DBX 160 feedforward topology: control voltage from input signal
-        float detectionLevel = std::abs(input);
+        storeLane(group, index, detector);
+    }
+    
+    // Fully linked gain stage for channels firstChannel onwards: the group's first lane
+    // runs its gain computer once per frame on the loudest channel and its gain is applied
+    // to every channel. The shared state is then copied to the group's lanes so metering
+    // and a later unlink carry on from it
+    template <bool OverEasy>
+    void processLinked(SampleType* const* channelData, int firstChannel, int numChannels, int start, int numSamples,
+                       const float* loudest, const BlockState& state)
+    {
+        const int lastChannel = firstChannel + numChannels;
+        LaneState detector = loadLane(detectorGroups[static_cast<size_t>(firstChannel / DETECTOR_LANES)],
+                                      static_cast<size_t>(firstChannel % DETECTOR_LANES));
         
-        // DBX 160 True RMS detection - closely simulates human ear response
-        // Uses proper RMS window suitable for program material
-        const float rmsTimeConstant = Constants::VCA_RMS_TIME_CONSTANT; // 3ms RMS averaging for transient response
-        const float rmsAlpha = std::exp(-1.0f / (juce::jmax(Constants::EPSILON, rmsTimeConstant * static_cast<float>(sampleRate))));
-        detector.rmsBuffer = detector.rmsBuffer * rmsAlpha + detectionLevel * detectionLevel * (1.0f - rmsAlpha);
-        float rmsLevel = std::sqrt(detector.rmsBuffer);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto gain = computeGain<OverEasy>(loudest[i], detector, state);
+            for (int channel = firstChannel; channel < lastChannel; ++channel)
+            {
+                auto& sample = channelData[channel][start + i];
+                sample = applyGain(sample, gain, reductions.getWritePointer(channel)[start + i]);
+            }
+        }
         
-        // Track signal envelope rate of change for program-dependent behavior
-        float signalDelta = std::abs(detectionLevel - detector.previousInput);
-        detector.envelopeRate = detector.envelopeRate * 0.95f + signalDelta * 0.05f;
-        detector.previousInput = detectionLevel;
+        for (int channel = firstChannel; channel < lastChannel; ++channel)
+            storeLane(detectorGroups[static_cast<size_t>(channel / DETECTOR_LANES)],
+                      static_cast<size_t>(channel % DETECTOR_LANES), detector);
+    }
+    
+    // Gain computer: curve, program-dependent timing and envelope for one frame
+    template <bool OverEasy>
+    Gain computeGain(float rmsMeanSquare, LaneState& detector, const BlockState& state)
+    {
+        float rmsLevel = std::sqrt(rmsMeanSquare);
         
         // DBX 160 signal envelope tracking for program-dependent timing
         const float envelopeAlpha = 0.99f;
         detector.signalEnvelope = detector.signalEnvelope * envelopeAlpha + rmsLevel * (1.0f - envelopeAlpha);
         
         // DBX 160 threshold control (-40dB to +20dB range typical)
-        float thresholdLin = juce::Decibels::decibelsToGain(threshold);
+        const float thresholdLin = state.thresholdLin;
         
         float reduction = 0.0f;
         if (rmsLevel > thresholdLin)
@@ -871,7 +2059,7 @@ public:
             float overThreshDb = juce::Decibels::gainToDecibels(rmsLevel / thresholdLin);
             
             // DBX 160 OverEasy mode - proprietary soft knee compression curve
-            if (overEasy)
+            if constexpr (OverEasy)
             {
                 // DBX OverEasy provides smooth transition into compression
                 // Knee width is approximately 10dB centered around threshold
@@ -890,19 +2078,19 @@ public:
                     float kneePosition = (overThreshDb - kneeStart) / kneeWidth;
                     // Cubic curve for smooth transition: f(x) = 3x² - 2x³
                     float kneeGain = 3.0f * kneePosition * kneePosition - 2.0f * kneePosition * kneePosition * kneePosition;
-                    reduction = overThreshDb * kneeGain * (1.0f - 1.0f / ratio);
+                    reduction = overThreshDb * kneeGain * state.slope;
                 }
                 else
                 {
                     // Above knee - full compression plus knee compensation
-                    float kneeReduction = kneeEnd * 0.5f * (1.0f - 1.0f / ratio); // Half reduction at knee end
-                    reduction = kneeReduction + (overThreshDb - kneeEnd) * (1.0f - 1.0f / ratio);
+                    float kneeReduction = kneeEnd * 0.5f * state.slope; // Half reduction at knee end
+                    reduction = kneeReduction + (overThreshDb - kneeEnd) * state.slope;
                 }
             }
             else
             {
                 // Hard knee compression (original DBX 160 without OverEasy)
-                reduction = overThreshDb * (1.0f - 1.0f / ratio);
+                reduction = overThreshDb * state.slope;
             }
             
             // DBX 160 can achieve infinite compression (approximately 120:1) with complete stability
@@ -915,27 +2103,25 @@ public:
         // Manual specifications: 15ms for 10dB, 5ms for 20dB, 3ms for 30dB change above threshold
         // Release rate: 120dB/second
         
-        float attackTime, releaseTime;
+        float attackCoeff, releaseTime;
         
         // DBX 160 attack times track the signal envelope rate
+        // The three attack times are fixed, so their coefficients are cached
         if (reduction > 0.1f)
         {
             // DBX 160 manual: Attack time for 63% of level change
             // 15ms for 10dB, 5ms for 20dB, 3ms for 30dB
             // Attack rates track the signal envelope
             if (reduction <= 10.0f)
-                attackTime = 0.015f; // 15ms for 10dB level change
+                attackCoeff = attackCoeff10dB; // 15ms for 10dB level change
             else if (reduction <= 20.0f)
-                attackTime = 0.005f; // 5ms for 20dB level change  
+                attackCoeff = attackCoeff20dB; // 5ms for 20dB level change  
             else
-                attackTime = 0.003f; // 3ms for 30dB level change
-            
-            // Ensure minimum attack time for stability
-            attackTime = juce::jmax(0.001f, attackTime);
+                attackCoeff = attackCoeff30dB; // 3ms for 30dB level change
         }
         else
         {
-            attackTime = 0.015f; // Default 15ms when not compressing
+            attackCoeff = attackCoeff10dB; // Default 15ms when not compressing
         }
         
         // DBX 160 release rate: constant 120dB/second regardless of program material
@@ -960,10 +2146,6 @@ public:
         // Feed-forward design is inherently stable even at infinite compression ratios
         float targetGain = juce::Decibels::decibelsToGain(-reduction);
         
-        // Calculate proper exponential coefficients for DBX-style response with safety
-        float attackCoeff = std::exp(-1.0f / (juce::jmax(Constants::EPSILON, attackTime * static_cast<float>(sampleRate))));
-        float releaseCoeff = std::exp(-1.0f / (juce::jmax(Constants::EPSILON, releaseTime * static_cast<float>(sampleRate))));
-        
         if (targetGain < detector.envelope)
         {
             // Attack phase - DBX feed-forward design for fast, stable response
@@ -972,6 +2154,8 @@ public:
         else
         {
             // Release phase - constant 120dB/second release rate
+            // Release time follows the reduction, so use the exp table
+            float releaseCoeff = lookupTables.envelopeCoefficient(releaseTime, sampleRateFloat);
             detector.envelope = targetGain + (detector.envelope - targetGain) * releaseCoeff;
         }
         
@@ -986,28 +2170,40 @@ public:
         // Store previous reduction for program dependency tracking
         detector.previousReduction = reduction;
         
+        return { detector.envelope, reduction };
+    }
+    
+    // Gain stage: applies the computed gain to one sample and records its reduction
+    static SampleType applyGain(SampleType input, const Gain& gain, float& reduction)
+    {
+        reduction = gain.reduction;
+        
         // DBX 160 feed-forward topology: apply compression to input signal
         // This is different from feedback compressors - much more stable
-        float compressed = input * detector.envelope;
-        
+        return input * gain.envelope;
+    }
+    
+    // Output stage: VCA colouration and output gain for one gain-reduced sample
+    SampleType processOutputStage(SampleType compressed, float reduction, const BlockState& state) const
+    {
         // DBX VCA characteristics (DBX 202 series VCA chip used in 160)
         // The DBX 160 is renowned for being EXTREMELY clean - much cleaner than most compressors
         // Manual specification: 0.075% 2nd harmonic at infinite compression at +4dBm output
         // 0.5% 3rd harmonic typical at infinite compression ratio
-        float processed = compressed;
-        float absLevel = std::abs(processed);
+        SampleType processed = compressed;
+        SampleType absLevel = std::abs(processed);
         
         // Calculate actual signal level in dB for harmonic generation
-        float levelDb = juce::Decibels::gainToDecibels(juce::jmax(0.0001f, absLevel));
+        float levelDb = juce::Decibels::gainToDecibels(juce::jmax(0.0001f, static_cast<float>(absLevel)));
         
         // DBX 160 harmonic distortion - much cleaner than other compressor types
         if (absLevel > 0.01f)  // Process non-silence
         {
-            float sign = (processed < 0.0f) ? -1.0f : 1.0f;
+            SampleType sign = (processed < 0.0f) ? -1.0f : 1.0f;
             
             // DBX 160 VCA harmonics - extremely clean, even at high compression ratios
-            float h2_level = 0.0f;
-            float h3_level = 0.0f;
+            SampleType h2_level = 0.0f;
+            SampleType h3_level = 0.0f;
             
             // No pre-saturation compensation needed anymore
             // We apply compensation AFTER saturation to avoid compression effects
@@ -1024,7 +2220,7 @@ public:
                 float compressionFactor = juce::jmin(1.0f, reduction / 30.0f);
                 
                 // Scale for 0.075% 2nd harmonic
-                float h2_scale = 0.00075f / (absLevel * absLevel + 0.0001f);  // Direct calculation
+                SampleType h2_scale = 0.00075f / (absLevel * absLevel + 0.0001f);  // Direct calculation
                 h2_level = absLevel * absLevel * h2_scale * compressionFactor * h2Boost;
                 
                 // DBX 160 manual spec: 0.5% 3rd harmonic typical at infinite compression
@@ -1034,7 +2230,7 @@ public:
                     // 3rd harmonic = 0.005 linear (0.5%)
                     // Account for frequency dependence (we're testing at 1kHz)
                     float freqFactor = 50.0f / 1000.0f;  // Linear decrease with frequency
-                    float h3_scale = (0.005f * freqFactor) / (absLevel * absLevel * absLevel + 0.0001f);
+                    SampleType h3_scale = (0.005f * freqFactor) / (absLevel * absLevel * absLevel + 0.0001f);
                     h3_level = absLevel * absLevel * absLevel * h3_scale * compressionFactor * h3Boost;
                 }
             }
@@ -1046,7 +2242,7 @@ public:
             if (h2_level > 0.0f)
             {
                 // Use waveshaping for consistent harmonic generation
-                float squared = compressed * compressed * sign;
+                SampleType squared = compressed * compressed * sign;
                 processed += squared * h2_level;
             }
             
@@ -1054,7 +2250,7 @@ public:
             if (h3_level > 0.0f)
             {
                 // Use waveshaping for consistent harmonic generation
-                float cubed = compressed * compressed * compressed;
+                SampleType cubed = compressed * compressed * compressed;
                 processed += cubed * h3_level;
             }
             
@@ -1062,120 +2258,355 @@ public:
             if (absLevel > 1.5f)
             {
                 // Very gentle VCA saturation characteristic
-                float excess = absLevel - 1.5f;
-                float vcaSat = 1.5f + std::tanh(excess * 0.3f) * 0.2f;
+                SampleType excess = absLevel - 1.5f;
+                SampleType vcaSat = 1.5f + std::tanh(excess * 0.3f) * 0.2f;
                 processed = sign * vcaSat * (processed / absLevel);
             }
         }
         
         // Apply output gain with proper VCA response
-        float output = processed * juce::Decibels::decibelsToGain(outputGain);
+        SampleType output = processed * state.outputGainLin;
         
         // Final output limiting for safety
-        return juce::jlimit(-Constants::OUTPUT_HARD_LIMIT, Constants::OUTPUT_HARD_LIMIT, output);
+        return limitOutput(output);
     }
     
-    float getGainReduction(int channel) const
+    // Sample-rate dependent coefficients, recomputed only from prepare()
+    void updateCoefficients()
     {
-        if (channel >= static_cast<int>(detectors.size()))
-            return 0.0f;
-        return juce::Decibels::gainToDecibels(detectors[channel].envelope);
+        if (sampleRate <= 0.0)
+            return;
+        
+        sampleRateFloat = static_cast<float>(sampleRate);
+        auto coefficientFor = [this](float timeSeconds)
+        {
+            return std::exp(-1.0f / (juce::jmax(Constants::EPSILON, timeSeconds * sampleRateFloat)));
+        };
+        rmsAlpha = coefficientFor(Constants::VCA_RMS_TIME_CONSTANT);
+        attackCoeff10dB = coefficientFor(0.015f);
+        attackCoeff20dB = coefficientFor(0.005f);
+        attackCoeff30dB = coefficientFor(0.003f);
     }
-
-private:
-    struct Detector
-    {
-        float envelope = 1.0f;
-        float rmsBuffer = 0.0f;         // True RMS detection buffer
-        float previousReduction = 0.0f; // For program-dependent behavior
-        float controlVoltage = 0.0f;    // VCA control voltage (-6mV/dB)
-        float signalEnvelope = 0.0f;    // Signal envelope for program-dependent timing
-        float envelopeRate = 0.0f;      // Rate of envelope change
-        float previousInput = 0.0f;     // Previous input for envelope tracking
-    };
     
-    std::vector<Detector> detectors;
+    const LookupTables& lookupTables;
+    std::vector<DetectorGroup> detectorGroups;
+    std::vector<DetectorFrames> frames;      // One per lane group
+    std::vector<float> loudestLevels;        // Stereo link scratch, one row per link group
+    juce::AudioBuffer<float> reductions;     // Host-rate gain reduction (dB) handed to the output stage
+    BlockState blockState;                   // Invariants of the block being processed
+    int numChannels = 0;
+    int saturationFactor = 1;                // Oversampling of the output stage
     double sampleRate = 0.0;  // Set by prepare() from DAW
+    float sampleRateFloat = 0.0f;
+    float rmsAlpha = 0.0f;           // 3ms true RMS window
+    float attackCoeff10dB = 0.0f;    // 15ms
+    float attackCoeff20dB = 0.0f;    // 5ms
+    float attackCoeff30dB = 0.0f;    // 3ms
 };
 
 // Bus Compressor (SSL style)
+// Audio path runs in SampleType, detection and gain computer in float
+template <typename SampleType>
 class UniversalCompressor::BusCompressor
 {
 public:
-    void prepare(double sampleRate, int numChannels, int blockSize = 512)
+    // The gain computer runs at the host rate, the console colouration at saturationFactor times it
+    void prepare(double sampleRate, int numChannels, int blockSize = 512, int saturationFactor = 1)
     {
         if (sampleRate <= 0.0 || numChannels <= 0 || blockSize <= 0)
             return;
             
         this->sampleRate = sampleRate;
-        detectors.clear();
-        detectors.resize(numChannels);
+        this->numChannels = numChannels;
+        this->saturationFactor = juce::jmax(1, saturationFactor);
         
-        // Initialize sidechain filters with actual block size
-        juce::dsp::ProcessSpec spec{sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(1)};
-        for (int ch = 0; ch < numChannels; ++ch)
+        // SSL G-Series sidechain: highpass at 60Hz to prevent pumping from low
+        // frequencies, no lowpass (full bandwidth) - runs in the SIMD detector kernel
+        detectorGroups.assign(getNumDetectorGroups(numChannels), DetectorGroup{});
+        frames.resize(detectorGroups.size());
+        for (auto& groupFrames : frames)
+            groupFrames.prepare(blockSize);
+        loudestLevels.assign(static_cast<size_t>(blockSize * juce::jmax(1, numChannels)), 0.0f);
+        reductions.setSize(numChannels, blockSize);
+        reductions.clear();
+    }
+    
+    // Block-rate parameters, read once per processBlock call
+    struct Params
+    {
+        float threshold = 0.0f;      // dB
+        float ratio = 2.0f;          // Actual ratio value (2.0, 4.0 or 10.0)
+        int attackIndex = 2;         // 0.1, 0.3, 1, 3, 10, 30ms
+        int releaseIndex = 1;        // 0.1, 0.3, 0.6, 1.2s, Auto
+        float makeupGain = 0.0f;     // dB
+        float stereoLink = 0.0f;     // 0-1, pull toward the loudest channel
+        const LinkGroups* linkGroups = nullptr;  // Channels linked together, nullptr = all of them
+    };
+    
+    // Sidechain and gain computer at the host rate. Leaves the gain-reduced signal in
+    // channelData and the per-sample reduction for processSaturation.
+    // keyData holds one detector key per channel, or nullptr to key each channel from itself
+    void processBlock(SampleType* const* channelData, const SampleType* const* keyData,
+                      int numChannels, int numSamples, const Params& params)
+    {
+        if (channelData == nullptr)
+            return;
+        if (keyData == nullptr)
+            keyData = channelData;
+        
+        // Safety check for sample rate
+        if (sampleRate <= 0.0)
+            return;
+        jassert(numSamples <= reductions.getNumSamples());  // The processor splits blocks to the prepared size
+        
+        const int channelsToProcess = juce::jmin(numChannels, this->numChannels);
+        
+        // Derive curve, timing and filter constants once for the whole block.
+        // The state is kept for the saturation pass over the same block
+        BlockState& state = blockState;
+        state = BlockState{};
+        state.thresholdLin = juce::Decibels::decibelsToGain(params.threshold);
+        
+        // SSL G-Series specific ratios: 2:1, 4:1, 10:1
+        state.slope = 1.0f - 1.0f / params.ratio;
+        
+        // SSL G-Series attack and release times
+        static constexpr std::array<float, 6> attackTimes = {0.1f, 0.3f, 1.0f, 3.0f, 10.0f, 30.0f}; // ms
+        static constexpr std::array<float, 5> releaseTimes = {100.0f, 300.0f, 600.0f, 1200.0f, -1.0f}; // ms, -1 = auto
+        state.attackTime = attackTimes[static_cast<size_t>(juce::jlimit(0, 5, params.attackIndex))] * 0.001f;
+        state.releaseTime = releaseTimes[static_cast<size_t>(juce::jlimit(0, 4, params.releaseIndex))] * 0.001f;
+        
+        // Envelope coefficients (SSL approximate exp) - release is per-sample only in auto mode
+        state.attackCoeff = approximateCoefficient(state.attackTime);
+        if (state.releaseTime >= 0.0f)
+            state.releaseCoeff = approximateCoefficient(state.releaseTime);
+        
+        // Simple 60Hz highpass filter coefficient for the sidechain
+        state.hpAlpha = juce::jmin(1.0f, 60.0f / static_cast<float>(sampleRate));
+        state.makeupGainLin = juce::Decibels::decibelsToGain(params.makeupGain);
+        const LinkGroups linkGroups = LinkGroups::forChannels(params.linkGroups, channelsToProcess);
+        const int numLinkGroups = linkGroups.getNumGroups();
+        state.link = linkGroups.linksAnyChannels() ? juce::jlimit(0.0f, 1.0f, params.stereoLink) : 0.0f;
+        
+        // Auto release selects a specialised gain stage once per block
+        const bool autoRelease = state.releaseTime < 0.0f;
+        const auto kernel = autoRelease ? &BusCompressor::processChannel<true>
+                                        : &BusCompressor::processChannel<false>;
+        const auto linkedKernel = autoRelease ? &BusCompressor::processLinked<true>
+                                              : &BusCompressor::processLinked<false>;
+        
+        // Feed-forward detection only sees the input, so every lane group runs the SIMD
+        // sidechain filter over the chunk first and the per-channel gain stage reads its result
+        const int numGroups = static_cast<int>(getNumDetectorGroups(channelsToProcess));
+        const int capacity = frames.front().getCapacity();
+        const bool fullyLinked = state.link >= Constants::FULL_STEREO_LINK;
+        for (int start = 0; start < numSamples; start += capacity)
         {
-            auto& detector = detectors[ch];
-            detector.envelope = 1.0f;
-            detector.rms = 0.0f;
-            detector.previousLevel = 0.0f;
-            detector.hpState = 0.0f;
-            detector.prevInput = 0.0f;
+            const int chunkSize = juce::jmin(capacity, numSamples - start);
+            {
+                UNIVERSAL_COMPRESSOR_STAGE_TIMER(Detector, chunkSize)
+                for (int group = 0; group < numGroups; ++group)
+                {
+                    const int firstChannel = group * DETECTOR_LANES;
+                    const int groupChannels = juce::jmin(DETECTOR_LANES, channelsToProcess - firstChannel);
+                    auto& groupFrames = frames[static_cast<size_t>(group)];
+                    
+                    groupFrames.load(keyData + firstChannel, groupChannels, start, chunkSize);
+                    runDetector(detectorGroups[static_cast<size_t>(group)], groupFrames, chunkSize, state);
+                }
+                
+                // Each link group is linked on its own
+                if (state.link > 0.0f)
+                {
+                    for (int linkGroup = 0; linkGroup < numLinkGroups; ++linkGroup)
+                    {
+                        findLoudestLevels(frames, linkGroups.getFirstChannel(linkGroup), linkGroups.getNumChannels(linkGroup),
+                                          chunkSize, loudestLevels.data() + linkGroup * capacity);
+                    }
+                    
+                    if (!fullyLinked)
+                    {
+                        for (int group = 0; group < numGroups; ++group)
+                            blendTowardLoudest(frames[static_cast<size_t>(group)], group * DETECTOR_LANES, loudestLevels.data(), capacity,
+                                               linkGroups, chunkSize, state.link);
+                    }
+                }
+            }
             
-            // Create the filter chain
-            detector.sidechainFilter = std::make_unique<juce::dsp::ProcessorChain<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Filter<float>>>();
+            UNIVERSAL_COMPRESSOR_STAGE_TIMER(GainEnvelope, chunkSize)
             
-            // SSL G-Series sidechain filter
-            // Highpass at 60Hz to prevent pumping from low frequencies
-            detector.sidechainFilter->get<0>().coefficients = 
-                juce::dsp::IIR::Coefficients<float>::makeHighPass(sampleRate, 60.0f, 0.707f);
-            // No lowpass in original SSL G - full bandwidth
-            detector.sidechainFilter->get<1>().coefficients = 
-                juce::dsp::IIR::Coefficients<float>::makeLowPass(sampleRate, 20000.0f, 0.707f);
+            // Fully linked, one gain computer drives every channel of a group
+            if (fullyLinked)
+            {
+                for (int linkGroup = 0; linkGroup < numLinkGroups; ++linkGroup)
+                {
+                    (this->*linkedKernel)(channelData, linkGroups.getFirstChannel(linkGroup), linkGroups.getNumChannels(linkGroup),
+                                          start, chunkSize, loudestLevels.data() + linkGroup * capacity, state);
+                }
+                continue;
+            }
             
-            // Then prepare and set bypass states
-            detector.sidechainFilter->prepare(spec);
-            detector.sidechainFilter->setBypassed<0>(false);
-            detector.sidechainFilter->setBypassed<1>(false);
+            for (int channel = 0; channel < channelsToProcess; ++channel)
+            {
+                const auto group = static_cast<size_t>(channel / DETECTOR_LANES);
+                (this->*kernel)(channelData[channel] + start, reductions.getWritePointer(channel, start), chunkSize,
+                                detectorGroups[group], frames[group], channel % DETECTOR_LANES, state);
+            }
         }
     }
     
-    float process(float input, int channel, float threshold, float ratio, 
-                  int attackIndex, int releaseIndex, float makeupGain, bool oversample = false)
+    // Console colouration and makeup over the block processBlock just gain-reduced, run
+    // at the saturation rate - numSamples is the host block times the saturation factor.
+    // Each host-rate reduction value is held across its oversampled frame
+    void processSaturation(SampleType* const* channelData, int numChannels, int numSamples)
     {
-        if (channel >= static_cast<int>(detectors.size()))
-            return input;
+        if (channelData == nullptr || sampleRate <= 0.0)
+            return;
         
-        // Safety check for sample rate
-        if (sampleRate <= 0.0)
-            return input;
+        const int channelsToProcess = juce::jmin(numChannels, this->numChannels);
+        const int numFrames = juce::jmin(numSamples / saturationFactor, reductions.getNumSamples());
+        for (int channel = 0; channel < channelsToProcess; ++channel)
+        {
+            SampleType* data = channelData[channel];
+            const float* reduction = reductions.getReadPointer(channel);
             
-        auto& detector = detectors[channel];
-        
-        // SSL G-Series quad VCA topology
-        // Uses parallel detection path with feed-forward design
+            for (int frame = 0, i = 0; frame < numFrames; ++frame)
+                for (int k = 0; k < saturationFactor; ++k, ++i)
+                    data[i] = processOutputStage(data[i], reduction[frame], blockState);
+        }
+    }
+    
+    float getGainReduction(int channel) const
+    {
+        if (channel < 0 || channel >= numChannels)
+            return 0.0f;
+        const auto& group = detectorGroups[static_cast<size_t>(channel / DETECTOR_LANES)];
+        return juce::Decibels::gainToDecibels(group.envelope.get(static_cast<size_t>(channel % DETECTOR_LANES)));
+    }
+
+private:
+    // Detector state in structure-of-arrays form, one lane per channel
+    struct DetectorGroup
+    {
+        DetectorLanes envelope = DetectorLanes::expand(1.0f);
+        DetectorLanes previousLevel = DetectorLanes::expand(0.0f); // For auto-release tracking
+        DetectorLanes hpState = DetectorLanes::expand(0.0f);       // Simple highpass filter state
+        DetectorLanes prevInput = DetectorLanes::expand(0.0f);     // Previous input for filter
+    };
+    
+    // Scalar copy of one lane's gain-stage state, kept in registers for the sample loop
+    struct LaneState
+    {
+        float envelope = 1.0f;
+        float previousLevel = 0.0f;
+    };
+    
+    // Per-block invariants derived from Params
+    struct BlockState
+    {
+        float thresholdLin = 1.0f;
+        float slope = 0.5f;              // 1 - 1/ratio
+        float attackTime = 0.001f;       // seconds
+        float releaseTime = 0.3f;        // seconds, negative = auto release
+        float attackCoeff = 0.0f;
+        float releaseCoeff = 0.0f;       // Unused in auto release
+        float hpAlpha = 0.0f;
+        float makeupGainLin = 1.0f;
+        float link = 0.0f;               // Stereo link, 0 when channels run independently
+    };
+    
+    // Gain computer output for one frame, consumed by the gain stage
+    struct Gain
+    {
+        float envelope = 1.0f;
+        float reduction = 0.0f;          // dB
+    };
+    
+    static LaneState loadLane(const DetectorGroup& group, size_t index)
+    {
+        LaneState detector;
+        detector.envelope = group.envelope.get(index);
+        detector.previousLevel = group.previousLevel.get(index);
+        return detector;
+    }
+    
+    static void storeLane(DetectorGroup& group, size_t index, const LaneState& detector)
+    {
+        group.envelope.set(index, detector.envelope);
+        group.previousLevel.set(index, detector.previousLevel);
+    }
+    
+    // SIMD sidechain kernel for one lane group, run in place over the frames.
+    // Leaves the detection level of every lane for the gain stage
+    void runDetector(DetectorGroup& group, DetectorFrames& groupFrames, int numSamples, const BlockState& state)
+    {
+        auto hpState = group.hpState;
+        auto prevInput = group.prevInput;
+        const float hpFeedback = 1.0f - state.hpAlpha;
         
-        // Step 2: Apply gain reduction to main signal
-        // Use simple inline filter instead of complex ProcessorChain for per-sample processing
-        float sidechainInput = input;
-        if (detector.sidechainFilter)
+        for (int i = 0; i < numSamples; ++i)
         {
+            // SSL G-Series quad VCA topology
+            // Uses parallel detection path with feed-forward design
             // Simple 60Hz highpass filter (much faster than full ProcessorChain)
-            const float hpCutoff = 60.0f / static_cast<float>(sampleRate);
-            const float hpAlpha = juce::jmin(1.0f, hpCutoff);
-            detector.hpState = input - detector.prevInput + detector.hpState * (1.0f - hpAlpha);
-            detector.prevInput = input;
-            sidechainInput = detector.hpState;
+            const auto input = groupFrames[i];
+            hpState = input - prevInput + hpState * hpFeedback;
+            prevInput = input;
+            
+            // SSL uses the sidechain signal directly for detection
+            groupFrames[i] = DetectorLanes::abs(hpState);
         }
         
-        // Step 3: SSL uses the sidechain signal directly for detection
-        float detectionLevel = std::abs(sidechainInput);
+        group.hpState = hpState;
+        group.prevInput = prevInput;
+    }
+    
+    // Gain stage for one channel of a lane group, driven by the detector frames.
+    // Specialised on auto release so the inner loop has no release-mode branch
+    template <bool AutoRelease>
+    void processChannel(SampleType* data, float* reduction, int numSamples, DetectorGroup& group,
+                        const DetectorFrames& groupFrames, int lane, const BlockState& state)
+    {
+        const auto index = static_cast<size_t>(lane);
+        LaneState detector = loadLane(group, index);
+        
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = applyGain(data[i], computeGain<AutoRelease>(groupFrames.get(i, lane), detector, state), reduction[i]);
         
-        // SSL G-Series specific ratios: 2:1, 4:1, 10:1
-        // ratio parameter already contains the actual ratio value (2.0, 4.0, or 10.0)
-        float actualRatio = ratio;
+        storeLane(group, index, detector);
+    }
+    
+    // Fully linked gain stage for channels firstChannel onwards: the group's first lane
+    // runs its gain computer once per frame on the loudest channel and its gain is applied
+    // to every channel, then the group's lanes take its state
+    template <bool AutoRelease>
+    void processLinked(SampleType* const* channelData, int firstChannel, int numChannels, int start, int numSamples,
+                       const float* loudest, const BlockState& state)
+    {
+        const int lastChannel = firstChannel + numChannels;
+        LaneState detector = loadLane(detectorGroups[static_cast<size_t>(firstChannel / DETECTOR_LANES)],
+                                      static_cast<size_t>(firstChannel % DETECTOR_LANES));
+        
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto gain = computeGain<AutoRelease>(loudest[i], detector, state);
+            for (int channel = firstChannel; channel < lastChannel; ++channel)
+            {
+                auto& sample = channelData[channel][start + i];
+                sample = applyGain(sample, gain, reductions.getWritePointer(channel)[start + i]);
+            }
+        }
         
-        float thresholdLin = juce::Decibels::decibelsToGain(threshold);
+        for (int channel = firstChannel; channel < lastChannel; ++channel)
+            storeLane(detectorGroups[static_cast<size_t>(channel / DETECTOR_LANES)],
+                      static_cast<size_t>(channel % DETECTOR_LANES), detector);
+    }
+    
+    // Gain computer: curve, release mode and envelope for one frame
+    template <bool AutoRelease>
+    Gain computeGain(float detectionLevel, LaneState& detector, const BlockState& state)
+    {
+        const float thresholdLin = state.thresholdLin;
         
         float reduction = 0.0f;
         if (detectionLevel > thresholdLin)
@@ -1183,21 +2614,17 @@ public:
             float overThreshDb = juce::Decibels::gainToDecibels(detectionLevel / thresholdLin);
             
             // SSL G-Series compression curve - relatively linear/hard knee
-            reduction = overThreshDb * (1.0f - 1.0f / actualRatio);
+            reduction = overThreshDb * state.slope;
             // SSL bus typically used for gentle compression (max ~20dB GR)
             reduction = juce::jmin(reduction, Constants::BUS_MAX_REDUCTION_DB);
         }
         
-        // SSL G-Series attack and release times
-        std::array<float, 6> attackTimes = {0.1f, 0.3f, 1.0f, 3.0f, 10.0f, 30.0f}; // ms
-        std::array<float, 5> releaseTimes = {100.0f, 300.0f, 600.0f, 1200.0f, -1.0f}; // ms, -1 = auto
-        
-        float attackTime = attackTimes[juce::jlimit(0, 5, attackIndex)] * 0.001f;
-        float releaseTime = releaseTimes[juce::jlimit(0, 4, releaseIndex)] * 0.001f;
+        float releaseCoeff = state.releaseCoeff;
         
         // SSL Auto-release mode - program-dependent, multi-stage
-        if (releaseTime < 0.0f)
+        if constexpr (AutoRelease)
         {
+            float releaseTime;
             // Auto release adapts to program material and compression amount
             float baseRelease = 0.1f;  // 100ms base
             float compressionFactor = juce::jlimit(0.0f, 1.0f, reduction / 6.0f); // Scale to 6dB
@@ -1210,6 +2637,7 @@ public:
                 releaseTime = baseRelease * (2.0f + compressionFactor * 8.0f); // 200-1000ms
                 
             detector.previousLevel = detector.previousLevel * 0.9f + detectionLevel * 0.1f; // Smooth tracking
+            releaseCoeff = approximateCoefficient(releaseTime);
         }
         
         // SSL G-Series envelope following with smooth response
@@ -1217,16 +2645,12 @@ public:
         
         if (targetGain < detector.envelope)
         {
-            // Attack phase - SSL is known for smooth attack response - approximate exp
-            float divisor = juce::jmax(Constants::EPSILON, attackTime * static_cast<float>(sampleRate));
-            float attackCoeff = juce::jmax(0.0f, juce::jmin(0.9999f, 1.0f - 1.0f / divisor));
-            detector.envelope = targetGain + (detector.envelope - targetGain) * attackCoeff;
+            // Attack phase - SSL is known for smooth attack response
+            detector.envelope = targetGain + (detector.envelope - targetGain) * state.attackCoeff;
         }
         else
         {
-            // Release phase with SSL's characteristic smoothness - approximate exp
-            float divisor = juce::jmax(Constants::EPSILON, releaseTime * static_cast<float>(sampleRate));
-            float releaseCoeff = juce::jmax(0.0f, juce::jmin(0.9999f, 1.0f - 1.0f / divisor));
+            // Release phase with SSL's characteristic smoothness
             detector.envelope = targetGain + (detector.envelope - targetGain) * releaseCoeff;
         }
         
@@ -1234,25 +2658,37 @@ public:
         if (std::isnan(detector.envelope) || std::isinf(detector.envelope))
             detector.envelope = 1.0f;
         
-        // Apply the gain reduction envelope to the input signal
-        float compressed = input * detector.envelope;
+        return { detector.envelope, reduction };
+    }
+    
+    // Gain stage: applies the computed gain to one sample and records its reduction
+    static SampleType applyGain(SampleType input, const Gain& gain, float& reduction)
+    {
+        reduction = gain.reduction;
         
+        // Apply the gain reduction envelope to the input signal
+        return input * gain.envelope;
+    }
+    
+    // Output stage: console colouration and makeup for one gain-reduced sample
+    SampleType processOutputStage(SampleType compressed, float reduction, const BlockState& state) const
+    {
         // SSL G-Series DBX 202C VCA characteristics
         // The SSL is known for its "glue" and subtle coloration
-        float processed = compressed;
-        float absLevel = std::abs(processed);
+        SampleType processed = compressed;
+        SampleType absLevel = std::abs(processed);
         
         // Calculate level for harmonic generation
-        float levelDb = juce::Decibels::gainToDecibels(juce::jmax(0.0001f, absLevel));
+        float levelDb = juce::Decibels::gainToDecibels(juce::jmax(0.0001f, static_cast<float>(absLevel)));
         
         // SSL Bus harmonics - very subtle unless pushed
         if (absLevel > 0.01f)
         {
-            float sign = (processed < 0.0f) ? -1.0f : 1.0f;
+            SampleType sign = (processed < 0.0f) ? -1.0f : 1.0f;
             
             // SSL VCA harmonics - extremely clean at normal levels
-            float h2_level = 0.0f;
-            float h3_level = 0.0f;
+            SampleType h2_level = 0.0f;
+            SampleType h3_level = 0.0f;
             
             // No pre-saturation compensation needed anymore
             // We apply compensation AFTER saturation to avoid compression effects
@@ -1272,7 +2708,7 @@ public:
                 float h2_db = -90.0f + pushFactor * 10.0f;  // More conservative range: -90 to -80dB
                 // Direct calculation from target dB
                 float h2_linear_target = std::pow(10.0f, h2_db / 20.0f);
-                float h2_scale = h2_linear_target / (absLevel * absLevel + 0.0001f);  // Avoid divide by zero
+                SampleType h2_scale = h2_linear_target / (absLevel * absLevel + 0.0001f);  // Avoid divide by zero
                 h2_level = absLevel * absLevel * h2_scale * h2Boost;
                 
                 // 3rd harmonic: -100dB when compressing hard
@@ -1293,7 +2729,7 @@ public:
             if (h2_level > 0.0f)
             {
                 // Use waveshaping: x² preserves phase relationship
-                float squared = compressed * compressed * sign;
+                SampleType squared = compressed * compressed * sign;
                 processed += squared * h2_level;
             }
             
@@ -1301,7 +2737,7 @@ public:
             if (h3_level > 0.0f)
             {
                 // Use waveshaping: x³ for odd harmonic
-                float cubed = compressed * compressed * compressed;
+                SampleType cubed = compressed * compressed * compressed;
                 processed += cubed * h3_level;
             }
             
@@ -1309,39 +2745,154 @@ public:
             if (absLevel > 0.95f)
             {
                 // SSL console output stage saturation
-                float excess = (absLevel - 0.95f) / 0.05f;
-                float sslSat = 0.95f + 0.05f * std::tanh(excess * 0.7f);
+                SampleType excess = (absLevel - 0.95f) / 0.05f;
+                SampleType sslSat = 0.95f + 0.05f * std::tanh(excess * 0.7f);
                 processed = sign * sslSat * (processed / absLevel);
             }
         }
         
         // Apply makeup gain
-        float output = processed * juce::Decibels::decibelsToGain(makeupGain);
+        SampleType output = processed * state.makeupGainLin;
         
         // Final output limiting
-        return juce::jlimit(-Constants::OUTPUT_HARD_LIMIT, Constants::OUTPUT_HARD_LIMIT, output);
+        return limitOutput(output);
     }
     
-    float getGainReduction(int channel) const
+    // SSL envelope coefficient - approximate exp
+    float approximateCoefficient(float timeSeconds) const
     {
-        if (channel >= static_cast<int>(detectors.size()))
-            return 0.0f;
-        return juce::Decibels::gainToDecibels(detectors[channel].envelope);
+        float divisor = juce::jmax(Constants::EPSILON, timeSeconds * static_cast<float>(sampleRate));
+        return juce::jmax(0.0f, juce::jmin(0.9999f, 1.0f - 1.0f / divisor));
     }
+    
+    std::vector<DetectorGroup> detectorGroups;
+    std::vector<DetectorFrames> frames;      // One per lane group
+    std::vector<float> loudestLevels;        // Stereo link scratch, one row per link group
+    juce::AudioBuffer<float> reductions;     // Host-rate gain reduction (dB) handed to the output stage
+    BlockState blockState;                   // Invariants of the block being processed
+    int numChannels = 0;
+    int saturationFactor = 1;                // Oversampling of the output stage
+    double sampleRate = 0.0;  // Set by prepare() from DAW
+};
 
-private:
-    struct Detector
+// Where a main bus channel sits in the speaker layout. Engine channels are ordered by
+// role so every surround link group is a run of consecutive channels
+enum class ChannelRole : int { Front = 0, Surround, Height, LFE };
+
+inline ChannelRole getChannelRole(juce::AudioChannelSet::ChannelType type)
+{
+    using Type = juce::AudioChannelSet::ChannelType;
+    switch (type)
     {
-        float envelope = 1.0f;
-        float rms = 0.0f;
-        float previousLevel = 0.0f; // For auto-release tracking
-        float hpState = 0.0f;       // Simple highpass filter state
-        float prevInput = 0.0f;     // Previous input for filter
-        std::unique_ptr<juce::dsp::ProcessorChain<juce::dsp::IIR::Filter<float>, juce::dsp::IIR::Filter<float>>> sidechainFilter;
-    };
+        case Type::left: case Type::right: case Type::centre:
+        case Type::leftCentre: case Type::rightCentre: case Type::wideLeft: case Type::wideRight:
+            return ChannelRole::Front;
+        case Type::topMiddle: case Type::topFrontLeft: case Type::topFrontCentre: case Type::topFrontRight:
+        case Type::topRearLeft: case Type::topRearCentre: case Type::topRearRight:
+        case Type::topSideLeft: case Type::topSideRight:
+            return ChannelRole::Height;
+        case Type::LFE: case Type::LFE2:
+            return ChannelRole::LFE;
+        default:
+            return ChannelRole::Surround;
+    }
+}
+
+// Engines and scratch buffers for one processing precision
+template <typename SampleType>
+struct UniversalCompressor::EngineSet
+{
+    explicit EngineSet(const LookupTables& tables) : opto(tables), fet(tables), vca(tables) {}
     
-    std::vector<Detector> detectors;
-    double sampleRate = 0.0;  // Set by prepare() from DAW
+    OptoCompressor<SampleType> opto;
+    FETCompressor<SampleType> fet;
+    VCACompressor<SampleType> vca;
+    BusCompressor<SampleType> bus;
+    AntiAliasing<SampleType> antiAliasing;
+    LookaheadDelay<SampleType> lookahead;
+    LookaheadDelay<SampleType> dryDelay;            // Oversampler latency for the dry copy, or the whole signal when bypassed
+    BandSplitter<SampleType> bandSplitter;          // Multiband split of the audio path
+    BandSplitter<SampleType> keySplitter;           // Matching split of an external or lookahead key
+    int numBands = 1;                               // Bands the engines were prepared for
+    std::vector<int> channelOrder;                  // Main bus channel of each engine channel in a band
+    std::vector<ChannelRole> channelRoles;          // Role of each engine channel in a band
+    
+    // Scratch, sized in prepareToPlay so the audio thread never allocates
+    int maxBlockSize = 0;                           // Longest block the engines and oversampler take
+    std::vector<SampleType*> channelPointers;       // Engine channel array
+    juce::AudioBuffer<SampleType> dryBuffer;        // Dry copy for parallel compression
+    std::vector<const SampleType*> keyPointers;     // Detector key per engine channel
+    juce::AudioBuffer<SampleType> lookaheadKey;     // Undelayed input keying the detectors
+    
+    int silentSamples = 0;                          // Input samples in a row below the idle floor
+    
+    float getGainReduction(CompressorMode mode, int channel) const
+    {
+        switch (mode)
+        {
+            case CompressorMode::Opto: return opto.getGainReduction(channel);
+            case CompressorMode::FET:  return fet.getGainReduction(channel);
+            case CompressorMode::VCA:  return vca.getGainReduction(channel);
+            case CompressorMode::Bus:  return bus.getGainReduction(channel);
+        }
+        return 0.0f;
+    }
+    
+    // Reduction shown on the meters - the deepest channel of the band starting at
+    // firstChannel
+    float getMeteredReduction(CompressorMode mode, int numChannels, int firstChannel = 0) const
+    {
+        float reduction = getGainReduction(mode, firstChannel);
+        for (int channel = firstChannel + 1; channel < firstChannel + numChannels; ++channel)
+            reduction = juce::jmin(reduction, getGainReduction(mode, channel));
+        return reduction;
+    }
+    
+    // Main bus channel feeding an engine channel. Falls back to the bus order when the
+    // host plays a different channel count than it prepared with
+    int getMainChannel(int engineChannel, int numMainChannels) const
+    {
+        const int channel = engineChannel % numMainChannels;
+        const bool ordered = static_cast<int>(channelOrder.size()) == numMainChannels;
+        return engineChannel - channel + (ordered ? channelOrder[static_cast<size_t>(channel)] : channel);
+    }
+    
+    // Link groups for one block. Every band is linked on its own, and within a band
+    // grouping 1 splits off the LFE and grouping 2 the surround, height and LFE channels
+    LinkGroups getLinkGroups(int grouping, int numMainChannels) const
+    {
+        const bool ordered = static_cast<int>(channelRoles.size()) == numMainChannels;
+        auto getGroupKey = [&](int channel)
+        {
+            const auto role = ordered ? channelRoles[static_cast<size_t>(channel)] : ChannelRole::Front;
+            if (grouping == 1)
+                return role == ChannelRole::LFE ? 1 : 0;
+            return grouping == 2 ? static_cast<int>(role) : 0;
+        };
+        
+        LinkGroups groups;
+        for (int band = 0; band < numBands; ++band)
+        {
+            int groupStart = 0;
+            for (int channel = 1; channel <= numMainChannels; ++channel)
+            {
+                if (channel < numMainChannels && getGroupKey(channel) == getGroupKey(groupStart))
+                    continue;
+                groups.add(channel - groupStart);
+                groupStart = channel;
+            }
+        }
+        return groups;
+    }
+    
+    // True once no channel of the active engine is reducing gain any more
+    bool isAtRest(CompressorMode mode, int numChannels) const
+    {
+        for (int channel = 0; channel < numChannels; ++channel)
+            if (getGainReduction(mode, channel) < -Constants::IDLE_MAX_REDUCTION_DB)
+                return false;
+        return true;
+    }
 };
 
 // Parameter layout creation
@@ -1356,17 +2907,65 @@ juce::AudioProcessorValueTreeState::ParameterLayout UniversalCompressor::createP
         "mode", "Mode", 
         juce::StringArray{"Opto", "FET", "VCA", "Bus"}, 2)); // Default to VCA
     
+    // Multiband: Linkwitz-Riley crossovers split the signal and the selected mode
+    // compresses each band on its own. The band count rebuilds the engines, so it is
+    // not automatable. 2 bands use the low crossover, 3 add the mid, 4 add the high
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "multiband", "Multiband", 
+        juce::StringArray{"Off", "2 Bands", "3 Bands", "4 Bands"}, 0,
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "crossover_low", "Low Crossover", 
+        juce::NormalisableRange<float>(40.0f, 1000.0f, 1.0f), 200.0f,
+        juce::AudioParameterFloatAttributes().withLabel("Hz")));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "crossover_mid", "Mid Crossover", 
+        juce::NormalisableRange<float>(300.0f, 5000.0f, 1.0f), 1500.0f,
+        juce::AudioParameterFloatAttributes().withLabel("Hz")));
+    layout.add(std::make_unique<juce::AudioParameterFloat>(
+        "crossover_high", "High Crossover", 
+        juce::NormalisableRange<float>(1500.0f, 16000.0f, 1.0f), 6000.0f,
+        juce::AudioParameterFloatAttributes().withLabel("Hz")));
+    
     // Global parameters
-    // Oversample removed - saturation always runs at 2x internally now
-    // layout.add(std::make_unique<juce::AudioParameterBool>("oversample", "Oversample", true));
     layout.add(std::make_unique<juce::AudioParameterBool>("bypass", "Bypass", false));
     
+    // Oversampling factor and filter. These rebuild the oversamplers and change the
+    // reported latency, so they are not automatable. Offline renders (bounces) can
+    // use their own factor, e.g. 1x while tracking and 8x for the final mix
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "oversampling", "Oversampling", 
+        juce::StringArray{"1x", "2x", "4x", "8x"}, 1,
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "oversampling_offline", "Offline Oversampling", 
+        juce::StringArray{"Same as Realtime", "1x", "2x", "4x", "8x"}, 0,
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "oversampling_filter", "Oversampling Filter", 
+        juce::StringArray{"IIR (Minimum Phase)", "FIR (Linear Phase)"}, 0,
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    
+    // Above this host rate the harmonics already sit below Nyquist for audible
+    // content, so oversampling drops to 1x in both realtime and offline use
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "oversampling_max_rate", "Oversample Up To", 
+        juce::StringArray{"All Rates", "48 kHz", "96 kHz"}, 0,
+        juce::AudioParameterChoiceAttributes().withAutomatable(false)));
+    
     // Stereo linking control (0% = independent, 100% = fully linked)
     layout.add(std::make_unique<juce::AudioParameterFloat>(
         "stereo_link", "Stereo Link", 
         juce::NormalisableRange<float>(0.0f, 100.0f, 1.0f), 100.0f,
         juce::AudioParameterFloatAttributes().withLabel("%")));
     
+    // Which channels of a surround bus the stereo link ties together. The LFE and
+    // each of the front, surround and height sets can follow their own detector.
+    // Mono and stereo buses only have front channels, so this changes nothing there
+    layout.add(std::make_unique<juce::AudioParameterChoice>(
+        "link_groups", "Link Groups", 
+        juce::StringArray{"All Channels", "All but LFE", "Front / Surround / Height"}, 1));
+    
     // Mix control for parallel compression (0% = dry, 100% = wet)
     layout.add(std::make_unique<juce::AudioParameterFloat>(
         "mix", "Mix", 
@@ -1387,11 +2986,15 @@ juce::AudioProcessorValueTreeState::ParameterLayout UniversalCompressor::createP
     layout.add(std::make_unique<juce::AudioParameterBool>(
         "sidechain_enable", "External Sidechain", false));
     
-    // Add read-only gain reduction meter parameter for DAW display (LV2/VST3)
+    // Lookahead delays the audio path so the detectors see peaks early.
+    // It changes the reported latency, so it is not automatable
     layout.add(std::make_unique<juce::AudioParameterFloat>(
-        "gr_meter", "GR", 
-        juce::NormalisableRange<float>(-30.0f, 0.0f, 0.1f), 0.0f,
-        juce::AudioParameterFloatAttributes().withLabel("dB")));
+        "lookahead", "Lookahead", 
+        juce::NormalisableRange<float>(0.0f, Constants::MAX_LOOKAHEAD_MS, 0.1f), 0.0f,
+        juce::AudioParameterFloatAttributes().withLabel("ms").withAutomatable(false)));
+    
+    // Read-only gain reduction meter for DAW display (LV2/VST3/AU), fed from grMeter
+    layout.add(std::make_unique<GainReductionMeterParameter>(grMeter));
     
     // Opto parameters (LA-2A style)
     layout.add(std::make_unique<juce::AudioParameterFloat>(
@@ -1464,44 +3067,6 @@ juce::AudioProcessorValueTreeState::ParameterLayout UniversalCompressor::createP
     return layout;
 }
 
-// Lookup table implementations
-void UniversalCompressor::LookupTables::initialize()
-{
-    // Precompute exponential values for range -4 to 0 (typical for envelope coefficients)
-    for (int i = 0; i < TABLE_SIZE; ++i)
-    {
-        float x = -4.0f + (4.0f * i / static_cast<float>(TABLE_SIZE - 1));
-        expTable[i] = std::exp(x);
-    }
-    
-    // Precompute logarithm values for range 0.0001 to 1.0
-    for (int i = 0; i < TABLE_SIZE; ++i)
-    {
-        float x = 0.0001f + (0.9999f * i / static_cast<float>(TABLE_SIZE - 1));
-        logTable[i] = std::log(x);
-    }
-}
-
-inline float UniversalCompressor::LookupTables::fastExp(float x) const
-{
-    // Clamp to table range
-    x = juce::jlimit(-4.0f, 0.0f, x);
-    // Map to table index
-    int index = static_cast<int>((x + 4.0f) * (TABLE_SIZE - 1) / 4.0f);
-    index = juce::jlimit(0, TABLE_SIZE - 1, index);
-    return expTable[index];
-}
-
-inline float UniversalCompressor::LookupTables::fastLog(float x) const
-{
-    // Clamp to table range
-    x = juce::jlimit(0.0001f, 1.0f, x);
-    // Map to table index
-    int index = static_cast<int>((x - 0.0001f) * (TABLE_SIZE - 1) / 0.9999f);
-    index = juce::jlimit(0, TABLE_SIZE - 1, index);
-    return logTable[index];
-}
-
 // Constructor
 UniversalCompressor::UniversalCompressor()
     : AudioProcessor(BusesProperties()
@@ -1517,46 +3082,166 @@ UniversalCompressor::UniversalCompressor()
     outputMeter.store(-60.0f);
     grMeter.store(0.0f);
     
+    resolveParameterHandles();
+    
+    // Lookahead and oversampling change the plugin latency, which the host must hear
+    // about off the audio thread
+    parameters.addParameterListener("lookahead", this);
+    parameters.addParameterListener("oversampling", this);
+    parameters.addParameterListener("oversampling_offline", this);
+    parameters.addParameterListener("oversampling_filter", this);
+    parameters.addParameterListener("oversampling_max_rate", this);
+    parameters.addParameterListener("multiband", this);
+    
     // Initialize lookup tables
     lookupTables = std::make_unique<LookupTables>();
     lookupTables->initialize();
     
     try {
-        // Initialize compressor instances with error handling
-        optoCompressor = std::make_unique<OptoCompressor>();
-        fetCompressor = std::make_unique<FETCompressor>();
-        vcaCompressor = std::make_unique<VCACompressor>();
-        busCompressor = std::make_unique<BusCompressor>();
-        antiAliasing = std::make_unique<AntiAliasing>();
+        // Initialize one engine set per processing precision with error handling
+        floatEngines = std::make_unique<EngineSet<float>>(*lookupTables);
+        doubleEngines = std::make_unique<EngineSet<double>>(*lookupTables);
     }
     catch (const std::exception& e) {
         // Ensure all pointers are null on failure
-        optoCompressor.reset();
-        fetCompressor.reset();
-        vcaCompressor.reset();
-        busCompressor.reset();
-        antiAliasing.reset();
+        floatEngines.reset();
+        doubleEngines.reset();
         DBG("Failed to initialize compressors: " << e.what());
     }
     catch (...) {
         // Ensure all pointers are null on failure
-        optoCompressor.reset();
-        fetCompressor.reset();
-        vcaCompressor.reset();
-        busCompressor.reset();
-        antiAliasing.reset();
+        floatEngines.reset();
+        doubleEngines.reset();
         DBG("Failed to initialize compressors: unknown error");
     }
 }
 
 UniversalCompressor::~UniversalCompressor() 
 {
+    cancelPendingUpdate();
+    parameters.removeParameterListener("lookahead", this);
+    parameters.removeParameterListener("oversampling", this);
+    parameters.removeParameterListener("oversampling_offline", this);
+    parameters.removeParameterListener("oversampling_filter", this);
+    parameters.removeParameterListener("oversampling_max_rate", this);
+    parameters.removeParameterListener("multiband", this);
+    
     // Explicitly reset all compressors in reverse order
-    antiAliasing.reset();
-    busCompressor.reset();
-    vcaCompressor.reset();
-    fetCompressor.reset();
-    optoCompressor.reset();
+    doubleEngines.reset();
+    floatEngines.reset();
+    
+    #if UNIVERSAL_COMPRESSOR_RT_SAFETY_CHECK
+        if (RealtimeSafetyCheck::getNumViolations() > 0)
+            juce::Logger::writeToLog(RealtimeSafetyCheck::describeViolations());
+    #endif
+}
+
+void UniversalCompressor::resolveParameterHandles()
+{
+    auto& h = parameterHandles;
+    h.mode = parameters.getRawParameterValue("mode");
+    h.bypass = parameters.getRawParameterValue("bypass");
+    h.stereoLink = parameters.getRawParameterValue("stereo_link");
+    h.linkGroups = parameters.getRawParameterValue("link_groups");
+    h.mix = parameters.getRawParameterValue("mix");
+    h.sidechainEnable = parameters.getRawParameterValue("sidechain_enable");
+    h.lookahead = parameters.getRawParameterValue("lookahead");
+    h.oversampling = parameters.getRawParameterValue("oversampling");
+    h.oversamplingOffline = parameters.getRawParameterValue("oversampling_offline");
+    h.oversamplingFilter = parameters.getRawParameterValue("oversampling_filter");
+    h.oversamplingMaxRate = parameters.getRawParameterValue("oversampling_max_rate");
+    h.multiband = parameters.getRawParameterValue("multiband");
+    h.crossoverLow = parameters.getRawParameterValue("crossover_low");
+    h.crossoverMid = parameters.getRawParameterValue("crossover_mid");
+    h.crossoverHigh = parameters.getRawParameterValue("crossover_high");
+    
+    h.optoPeakReduction = parameters.getRawParameterValue("opto_peak_reduction");
+    h.optoGain = parameters.getRawParameterValue("opto_gain");
+    h.optoLimit = parameters.getRawParameterValue("opto_limit");
+    
+    h.fetInput = parameters.getRawParameterValue("fet_input");
+    h.fetOutput = parameters.getRawParameterValue("fet_output");
+    h.fetAttack = parameters.getRawParameterValue("fet_attack");
+    h.fetRelease = parameters.getRawParameterValue("fet_release");
+    h.fetRatio = parameters.getRawParameterValue("fet_ratio");
+    
+    h.vcaThreshold = parameters.getRawParameterValue("vca_threshold");
+    h.vcaRatio = parameters.getRawParameterValue("vca_ratio");
+    h.vcaAttack = parameters.getRawParameterValue("vca_attack");
+    h.vcaRelease = parameters.getRawParameterValue("vca_release");
+    h.vcaOutput = parameters.getRawParameterValue("vca_output");
+    h.vcaOverEasy = parameters.getRawParameterValue("vca_overeasy");
+    
+    h.busThreshold = parameters.getRawParameterValue("bus_threshold");
+    h.busRatio = parameters.getRawParameterValue("bus_ratio");
+    h.busAttack = parameters.getRawParameterValue("bus_attack");
+    h.busRelease = parameters.getRawParameterValue("bus_release");
+    h.busMakeup = parameters.getRawParameterValue("bus_makeup");
+    
+    const std::atomic<float>* all[] = {
+        h.mode, h.bypass, h.stereoLink, h.linkGroups, h.mix, h.sidechainEnable, h.lookahead,
+        h.oversampling, h.oversamplingOffline, h.oversamplingFilter, h.oversamplingMaxRate,
+        h.multiband, h.crossoverLow, h.crossoverMid, h.crossoverHigh,
+        h.optoPeakReduction, h.optoGain, h.optoLimit,
+        h.fetInput, h.fetOutput, h.fetAttack, h.fetRelease, h.fetRatio,
+        h.vcaThreshold, h.vcaRatio, h.vcaAttack, h.vcaRelease, h.vcaOutput, h.vcaOverEasy,
+        h.busThreshold, h.busRatio, h.busAttack, h.busRelease, h.busMakeup
+    };
+    h.allResolved = std::all_of(std::begin(all), std::end(all),
+                                [](const std::atomic<float>* p) { return p != nullptr; });
+    jassert(h.allResolved);  // Every ID above must exist in createParameterLayout()
+}
+
+UniversalCompressor::ParameterSnapshot UniversalCompressor::takeParameterSnapshot() const
+{
+    // Relaxed loads are enough - each value is independent and only needs to be
+    // read once per block, not ordered against the other parameters
+    const auto& h = parameterHandles;
+    auto read = [](const std::atomic<float>* p) { return p->load(std::memory_order_relaxed); };
+    
+    ParameterSnapshot s;
+    s.mode = static_cast<CompressorMode>(juce::jlimit(0, 3, static_cast<int>(read(h.mode))));
+    s.bypass = read(h.bypass) > 0.5f;
+    s.stereoLink = read(h.stereoLink) * 0.01f; // Convert to 0-1
+    s.linkGroups = juce::jlimit(0, 2, static_cast<int>(read(h.linkGroups)));
+    s.mix = read(h.mix) * 0.01f;               // Convert to 0-1
+    s.sidechainEnable = read(h.sidechainEnable) > 0.5f;
+    s.lookaheadMs = read(h.lookahead);
+    s.crossoverHz = {read(h.crossoverLow), read(h.crossoverMid), read(h.crossoverHigh)};
+    
+    s.optoPeakReduction = read(h.optoPeakReduction);
+    // LA-2A gain is 0-40dB range, parameter is 0-100
+    // Map 50 = unity gain (0dB), 0 = -40dB, 100 = +40dB
+    s.optoGain = (read(h.optoGain) - 50.0f) * 0.8f; // -40 to +40 dB
+    s.optoLimit = read(h.optoLimit) > 0.5f;
+    
+    s.fetInput = read(h.fetInput);
+    s.fetOutput = read(h.fetOutput);
+    s.fetAttack = read(h.fetAttack);
+    s.fetRelease = read(h.fetRelease);
+    s.fetRatio = static_cast<int>(read(h.fetRatio));
+    
+    s.vcaThreshold = read(h.vcaThreshold);
+    s.vcaRatio = read(h.vcaRatio);
+    s.vcaAttack = read(h.vcaAttack);
+    s.vcaRelease = read(h.vcaRelease);
+    s.vcaOutput = read(h.vcaOutput);
+    s.vcaOverEasy = read(h.vcaOverEasy) > 0.5f;
+    
+    s.busThreshold = read(h.busThreshold);
+    // Convert discrete ratio choice to actual ratio value
+    switch (static_cast<int>(read(h.busRatio)))
+    {
+        case 0: s.busRatio = 2.0f; break;  // 2:1
+        case 1: s.busRatio = 4.0f; break;  // 4:1
+        case 2: s.busRatio = 10.0f; break; // 10:1
+        default: s.busRatio = 2.0f; break;
+    }
+    s.busAttack = static_cast<int>(read(h.busAttack));
+    s.busRelease = static_cast<int>(read(h.busRelease));
+    s.busMakeup = read(h.busMakeup);
+    
+    return s;
 }
 
 void UniversalCompressor::prepareToPlay(double sampleRate, int samplesPerBlock)
@@ -1567,24 +3252,162 @@ void UniversalCompressor::prepareToPlay(double sampleRate, int samplesPerBlock)
     currentSampleRate = sampleRate;
     currentBlockSize = samplesPerBlock;
     
-    int numChannels = juce::jmax(1, getTotalNumOutputChannels());
+    prepareAllEngines();
+    updateLatency();
+}
+
+void UniversalCompressor::prepareAllEngines()
+{
+    // Any pending structural change is picked up below
+    enginesNeedRebuild.store(false, std::memory_order_relaxed);
+    
+    // Resolve the oversampling for this context - offline renders may ask for their own factor
+    oversamplingStages = 1;
+    oversamplingLinearPhase = false;
+    multibandBands = 1;
+    if (parameterHandles.allResolved)
+    {
+        const int offlineChoice = static_cast<int>(parameterHandles.oversamplingOffline->load(std::memory_order_relaxed));
+        if (isNonRealtime() && offlineChoice > 0)
+            oversamplingStages = offlineChoice - 1;
+        else
+            oversamplingStages = static_cast<int>(parameterHandles.oversampling->load(std::memory_order_relaxed));
+        oversamplingLinearPhase = parameterHandles.oversamplingFilter->load(std::memory_order_relaxed) > 0.5f;
+        
+        // High host rates skip oversampling altogether, which also removes its latency
+        static constexpr std::array<double, 3> maxRates = {0.0, 48000.0, 96000.0}; // 0 = no limit
+        const int maxRateChoice = juce::jlimit(0, 2, static_cast<int>(parameterHandles.oversamplingMaxRate->load(std::memory_order_relaxed)));
+        const double maxRate = maxRates[static_cast<size_t>(maxRateChoice)];
+        if (maxRate > 0.0 && currentSampleRate > maxRate + 1.0)
+            oversamplingStages = 0;
+        
+        // Off, 2, 3 or 4 bands
+        multibandBands = 1 + juce::jlimit(0, MAX_BANDS - 1, static_cast<int>(parameterHandles.multiband->load(std::memory_order_relaxed)));
+    }
+    
+    // Both precisions are prepared so either processBlock overload is ready to run
+    if (floatEngines)
+        prepareEngines(*floatEngines, currentSampleRate, currentBlockSize);
+    if (doubleEngines)
+        prepareEngines(*doubleEngines, currentSampleRate, currentBlockSize);
+}
+
+void UniversalCompressor::reprepareEngines()
+{
+    if (currentSampleRate <= 0.0)
+        return;
+    
+    // The oversamplers are rebuilt here on the message thread. Holding processing
+    // keeps the audio thread out of processBlock while they are swapped
+    suspendProcessing(true);
+    prepareAllEngines();
+    updateLatency();
+    suspendProcessing(false);
+}
+
+void UniversalCompressor::setNonRealtime(bool isNonRealtime) noexcept
+{
+    const bool changed = isNonRealtime != this->isNonRealtime();
+    AudioProcessor::setNonRealtime(isNonRealtime);
+    
+    // Hosts don't always re-prepare when switching to an offline bounce
+    if (changed && parameterHandles.allResolved
+        && parameterHandles.oversamplingOffline->load(std::memory_order_relaxed) > 0.5f)
+        reprepareEngines();
+}
+
+int UniversalCompressor::getLookaheadSamples(float lookaheadMs) const
+{
+    return juce::roundToInt(juce::jlimit(0.0f, Constants::MAX_LOOKAHEAD_MS, lookaheadMs) * 0.001 * currentSampleRate);
+}
+
+void UniversalCompressor::updateLatency()
+{
+    // Oversampling latency in the precision the host uses, plus the lookahead delay
+    int latency = 0;
+    if (isUsingDoublePrecision())
+        latency = doubleEngines ? doubleEngines->antiAliasing.getLatency() : 0;
+    else
+        latency = floatEngines ? floatEngines->antiAliasing.getLatency() : 0;
+    
+    if (parameterHandles.lookahead != nullptr)
+        latency += getLookaheadSamples(parameterHandles.lookahead->load(std::memory_order_relaxed));
+    
+    setLatencySamples(latency);
+}
+
+void UniversalCompressor::parameterChanged(const juce::String& parameterID, float)
+{
+    // Listeners run on whichever thread set the parameter, and the VST3 wrapper applies
+    // host changes inside process(). So only flag the change here - the engines are
+    // rebuilt and the latency reported from the message thread
+    if (parameterID != "lookahead")
+        enginesNeedRebuild.store(true, std::memory_order_relaxed);
+    triggerAsyncUpdate();
+}
+
+void UniversalCompressor::handleAsyncUpdate()
+{
+    // Before prepareToPlay there is nothing to rebuild, it reads the parameters itself
+    if (currentSampleRate <= 0.0)
+        return;
+    
+    if (enginesNeedRebuild.exchange(false, std::memory_order_relaxed))
+        reprepareEngines();
+    else
+        updateLatency();
+}
+
+template <typename SampleType>
+void UniversalCompressor::prepareEngines(EngineSet<SampleType>& engines, double sampleRate, int samplesPerBlock)
+{
+    // In multiband mode every band is a further set of channels for the engines
+    // and the oversampler
+    engines.numBands = juce::jlimit(1, MAX_BANDS, multibandBands);
+    int numChannels = juce::jmax(1, getTotalNumOutputChannels()) * engines.numBands;
+    engines.channelPointers.assign(static_cast<size_t>(numChannels), nullptr);
+    engines.keyPointers.assign(static_cast<size_t>(numChannels), nullptr);
+    
+    // Engine channels run front, surround, height then LFE so the link groups of a
+    // surround bus are consecutive. Stereo and mono keep the bus order
+    const auto mainLayout = getChannelLayoutOfBus(false, 0);
+    const int numMainChannels = mainLayout.size();
+    engines.channelOrder.resize(static_cast<size_t>(numMainChannels));
+    std::iota(engines.channelOrder.begin(), engines.channelOrder.end(), 0);
+    std::stable_sort(engines.channelOrder.begin(), engines.channelOrder.end(), [&](int a, int b)
+    {
+        return getChannelRole(mainLayout.getTypeOfChannel(a)) < getChannelRole(mainLayout.getTypeOfChannel(b));
+    });
+    engines.channelRoles.resize(static_cast<size_t>(numMainChannels));
+    for (int channel = 0; channel < numMainChannels; ++channel)
+        engines.channelRoles[static_cast<size_t>(channel)] = getChannelRole(mainLayout.getTypeOfChannel(engines.channelOrder[static_cast<size_t>(channel)]));
+    
+    // Scratch buffers are allocated here once and reused by every processBlock call
+    const int numBufferChannels = juce::jmax(getTotalNumInputChannels(), getTotalNumOutputChannels(), 1);
+    engines.maxBlockSize = samplesPerBlock;
+    engines.dryBuffer.setSize(numBufferChannels, samplesPerBlock);
+    engines.lookaheadKey.setSize(numBufferChannels, samplesPerBlock);
+    
+    // The delay line holds the longest lookahead at the host rate
+    engines.lookahead.prepare(numBufferChannels, getLookaheadSamples(Constants::MAX_LOOKAHEAD_MS));
+    
+    // Crossovers for the audio path and the detector key
+    engines.bandSplitter.prepare(sampleRate, numBufferChannels, samplesPerBlock);
+    engines.keySplitter.prepare(sampleRate, numBufferChannels, samplesPerBlock);
     
-    // Prepare all compressor types safely
-    if (optoCompressor)
-        optoCompressor->prepare(sampleRate, numChannels);
-    if (fetCompressor)
-        fetCompressor->prepare(sampleRate, numChannels);
-    if (vcaCompressor)
-        vcaCompressor->prepare(sampleRate, numChannels);
-    if (busCompressor)
-        busCompressor->prepare(sampleRate, numChannels, samplesPerBlock);
+    // Prepare anti-aliasing for the oversampled output stages
+    engines.antiAliasing.prepare(sampleRate, samplesPerBlock, numChannels, oversamplingStages, oversamplingLinearPhase);
+    engines.dryDelay.prepare(numBufferChannels, engines.antiAliasing.getLatency());
     
-    // Prepare anti-aliasing for internal oversampling
-    if (antiAliasing)
-        antiAliasing->prepare(sampleRate, samplesPerBlock, numChannels);
+    // Detection and gain computers run at the host rate, only the saturation stages
+    // see the oversampled stream
+    const int factor = engines.antiAliasing.getOversamplingFactor();
     
-    // Set latency based on oversampling
-    setLatencySamples(antiAliasing ? antiAliasing->getLatency() : 0);
+    // Prepare all compressor types
+    engines.opto.prepare(sampleRate, numChannels, factor);
+    engines.fet.prepare(sampleRate, numChannels, samplesPerBlock, factor);
+    engines.vca.prepare(sampleRate, numChannels, samplesPerBlock, factor);
+    engines.bus.prepare(sampleRate, numChannels, samplesPerBlock, factor);
 }
 
 void UniversalCompressor::releaseResources()
@@ -1592,7 +3415,63 @@ void UniversalCompressor::releaseResources()
     // Nothing specific to release
 }
 
+bool UniversalCompressor::isBusesLayoutSupported(const BusesLayout& layouts) const
+{
+    // Main input and output match, from mono up to 7.1.4
+    const auto mainLayout = layouts.getMainOutputChannelSet();
+    if (mainLayout != layouts.getMainInputChannelSet())
+        return false;
+    
+    const juce::AudioChannelSet supported[] = {
+        juce::AudioChannelSet::mono(), juce::AudioChannelSet::stereo(), juce::AudioChannelSet::createLCR(),
+        juce::AudioChannelSet::create5point0(), juce::AudioChannelSet::create5point1(),
+        juce::AudioChannelSet::create7point0(), juce::AudioChannelSet::create7point1(),
+        juce::AudioChannelSet::create5point1point4(), juce::AudioChannelSet::create7point0point4(),
+        juce::AudioChannelSet::create7point1point4()
+    };
+    if (std::find(std::begin(supported), std::end(supported), mainLayout) == std::end(supported))
+        return false;
+    
+    // The sidechain is off, mono, stereo or the same layout as the main bus
+    const auto sidechainLayout = layouts.getChannelSet(true, 1);
+    return sidechainLayout.isDisabled()
+        || sidechainLayout == juce::AudioChannelSet::mono()
+        || sidechainLayout == juce::AudioChannelSet::stereo()
+        || sidechainLayout == mainLayout;
+}
+
 void UniversalCompressor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    UNIVERSAL_COMPRESSOR_AUDIO_CALLBACK_SCOPE
+    
+    const bool timing = cpuTimingEnabled.load(std::memory_order_relaxed);
+    const juce::int64 startTicks = timing ? juce::Time::getHighResolutionTicks() : 0;
+    
+    // Check for valid compressor instances
+    if (floatEngines)
+        processEngines(buffer, *floatEngines);
+    
+    if (timing && currentSampleRate > 0.0)
+        cpuLoad.add(juce::Time::getHighResolutionTicks() - startTicks, buffer.getNumSamples() / currentSampleRate);
+}
+
+void UniversalCompressor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer&)
+{
+    UNIVERSAL_COMPRESSOR_AUDIO_CALLBACK_SCOPE
+    
+    const bool timing = cpuTimingEnabled.load(std::memory_order_relaxed);
+    const juce::int64 startTicks = timing ? juce::Time::getHighResolutionTicks() : 0;
+    
+    // Native double-precision path - no conversion to float
+    if (doubleEngines)
+        processEngines(buffer, *doubleEngines);
+    
+    if (timing && currentSampleRate > 0.0)
+        cpuLoad.add(juce::Time::getHighResolutionTicks() - startTicks, buffer.getNumSamples() / currentSampleRate);
+}
+
+template <typename SampleType>
+void UniversalCompressor::processEngines(juce::AudioBuffer<SampleType>& buffer, EngineSet<SampleType>& engines)
 {
     // Improved denormal prevention - more efficient than ScopedNoDenormals
     #if JUCE_INTEL
@@ -1606,267 +3485,311 @@ void UniversalCompressor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     if (buffer.getNumSamples() == 0 || buffer.getNumChannels() == 0)
         return;
     
-    // Check for valid compressor instances
-    if (!optoCompressor || !fetCompressor || !vcaCompressor || !busCompressor)
+    // Check for valid parameter handles, then read every parameter once for this block
+    if (!parameterHandles.allResolved)
         return;
     
-    // Check for valid parameter pointers and bypass
-    auto* bypassParam = parameters.getRawParameterValue("bypass");
-    if (!bypassParam || *bypassParam > 0.5f)
+    const ParameterSnapshot snapshot = takeParameterSnapshot();
+    
+    // Main input/output and external sidechain are views into the host buffer - nothing is copied
+    auto mainBuffer = getBusBuffer(buffer, true, 0);
+    if (mainBuffer.getNumSamples() == 0 || mainBuffer.getNumChannels() == 0)
+        return;
+    
+    // Bypass still delays the signal by the reported latency, so the host's compensation
+    // holds and switching doesn't jump in time
+    if (snapshot.bypass)
+    {
+        engines.lookahead.process(mainBuffer.getArrayOfWritePointers(), mainBuffer.getNumChannels(),
+                                  mainBuffer.getNumSamples(), getLookaheadSamples(snapshot.lookaheadMs));
+        engines.dryDelay.process(mainBuffer.getArrayOfWritePointers(), mainBuffer.getNumChannels(),
+                                 mainBuffer.getNumSamples(), engines.antiAliasing.getLatency());
         return;
+    }
+    
+    #if UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+    const StageTimer::ScopedMode stageTimerMode(stageTimings[static_cast<size_t>(snapshot.mode)].data());
+    #endif
     
-    // Get stereo link and mix parameters
-    auto* stereoLinkParam = parameters.getRawParameterValue("stereo_link");
-    auto* mixParam = parameters.getRawParameterValue("mix");
-    auto* sidechainEnableParam = parameters.getRawParameterValue("sidechain_enable");
-    float stereoLinkAmount = stereoLinkParam ? (*stereoLinkParam * 0.01f) : 1.0f; // Convert to 0-1
-    float mixAmount = mixParam ? (*mixParam * 0.01f) : 1.0f; // Convert to 0-1
-    bool useSidechain = sidechainEnableParam ? (*sidechainEnableParam > 0.5f) : false;
+    float stereoLinkAmount = snapshot.stereoLink;
+    float mixAmount = snapshot.mix;
+    bool useSidechain = snapshot.sidechainEnable;
     
-    // Store dry signal for parallel compression
-    juce::AudioBuffer<float> dryBuffer;
-    if (mixAmount < 1.0f)
+    // External key from the sidechain bus, only when it is active and carries channels
+    const auto* sidechainBus = getBus(true, 1);
+    useSidechain = useSidechain && sidechainBus != nullptr && sidechainBus->isEnabled()
+                && sidechainBus->getNumberOfChannels() > 0;
+    juce::AudioBuffer<SampleType> keyBuffer;
+    if (useSidechain)
+        keyBuffer = getBusBuffer(buffer, true, 1);
+    
+    const int lookaheadSamples = getLookaheadSamples(snapshot.lookaheadMs);
+    
+    // Idle skip: once input and key have been below the floor for longer than the
+    // latency and the detectors have fully recovered, the block passes through untouched.
+    // The delay line and oversampler hold only silence by then and the detectors are at
+    // rest, so processing picks up seamlessly when signal returns
+    // The input peak doubles as the input meter reading below, so the block is read once
+    const int blockSamples = mainBuffer.getNumSamples();
+    const SampleType inputPeak = mainBuffer.getMagnitude(0, blockSamples);
+    SampleType blockPeak = inputPeak;
+    if (useSidechain)
+        blockPeak = juce::jmax(blockPeak, keyBuffer.getMagnitude(0, blockSamples));
+    if (blockPeak < static_cast<SampleType>(Constants::IDLE_FLOOR))
+        engines.silentSamples = juce::jmin(engines.silentSamples + blockSamples, std::numeric_limits<int>::max() / 2);
+    else
+        engines.silentSamples = 0;
+    
+    const int tailSamples = lookaheadSamples + engines.antiAliasing.getLatency();
+    if (engines.silentSamples - blockSamples >= tailSamples
+        && engines.isAtRest(snapshot.mode, mainBuffer.getNumChannels() * engines.numBands))
     {
-        dryBuffer.makeCopyOf(buffer);
+        for (auto& bandMeter : bandGrMeters)
+            bandMeter.store(0.0f);
+        publishMeters(MeterFrame{});
+        return;
     }
     
-    // Get sidechain buffer if available and enabled
-    juce::AudioBuffer<float> sidechainBuffer;
-    if (useSidechain && getTotalNumInputChannels() > 2)
+    // Lookahead: without an external key the detectors read the undelayed input,
+    // then the audio path (and the dry copy below) is delayed by the same amount
     {
-        // Create a temporary buffer for sidechain (channels 2 and 3 if they exist)
-        const int sidechainChannels = juce::jmin(2, getTotalNumInputChannels() - 2);
-        if (sidechainChannels > 0)
+        UNIVERSAL_COMPRESSOR_STAGE_TIMER(Lookahead, blockSamples)
+        if (lookaheadSamples > 0 && !useSidechain)
         {
-            sidechainBuffer.setSize(sidechainChannels, buffer.getNumSamples());
-            // Note: In a real implementation, you'd get the sidechain from the second input bus
-            // For now, we'll use a simplified approach
-            // This would need proper multi-bus support in the processBlock override
+            engines.lookaheadKey.setSize(mainBuffer.getNumChannels(), mainBuffer.getNumSamples(), false, false, true);
+            for (int ch = 0; ch < mainBuffer.getNumChannels(); ++ch)
+                engines.lookaheadKey.copyFrom(ch, 0, mainBuffer, ch, 0, mainBuffer.getNumSamples());
         }
+        engines.lookahead.process(mainBuffer.getArrayOfWritePointers(), mainBuffer.getNumChannels(),
+                                  mainBuffer.getNumSamples(), lookaheadSamples);
     }
     
-    // Internal oversampling is always enabled for better quality
-    bool oversample = true; // Always use oversampling internally
-    CompressorMode mode = getCurrentMode();
-    
-    // Cache parameters based on mode to avoid repeated lookups
-    float cachedParams[6] = {0.0f}; // Max 6 params for any mode
-    bool validParams = true;
+    const bool useKey = useSidechain || lookaheadSamples > 0;
     
-    switch (mode)
+    // Store dry signal for parallel compression, delayed by the oversampler latency
+    // so it lines up with the wet signal when they are blended.
+    // The scratch buffers keep their prepareToPlay storage and only grow if the
+    // host exceeds the block size it announced
+    if (mixAmount < 1.0f)
     {
-        case CompressorMode::Opto:
-        {
-            auto* p1 = parameters.getRawParameterValue("opto_peak_reduction");
-            auto* p2 = parameters.getRawParameterValue("opto_gain");
-            auto* p3 = parameters.getRawParameterValue("opto_limit");
-            if (p1 && p2 && p3) {
-                cachedParams[0] = *p1;
-                // LA-2A gain is 0-40dB range, parameter is 0-100
-                // Map 50 = unity gain (0dB), 0 = -40dB, 100 = +40dB
-                float gainParam = *p2;
-                cachedParams[1] = (gainParam - 50.0f) * 0.8f; // -40 to +40 dB
-                cachedParams[2] = *p3;
-            } else validParams = false;
-            break;
-        }
-        case CompressorMode::FET:
-        {
-            auto* p1 = parameters.getRawParameterValue("fet_input");
-            auto* p2 = parameters.getRawParameterValue("fet_output");
-            auto* p3 = parameters.getRawParameterValue("fet_attack");
-            auto* p4 = parameters.getRawParameterValue("fet_release");
-            auto* p5 = parameters.getRawParameterValue("fet_ratio");
-            if (p1 && p2 && p3 && p4 && p5) {
-                cachedParams[0] = *p1;
-                cachedParams[1] = *p2;
-                cachedParams[2] = *p3;
-                cachedParams[3] = *p4;
-                cachedParams[4] = *p5;
-            } else validParams = false;
-            break;
-        }
-        case CompressorMode::VCA:
-        {
-            auto* p1 = parameters.getRawParameterValue("vca_threshold");
-            auto* p2 = parameters.getRawParameterValue("vca_ratio");
-            auto* p3 = parameters.getRawParameterValue("vca_attack");
-            auto* p4 = parameters.getRawParameterValue("vca_release");
-            auto* p5 = parameters.getRawParameterValue("vca_output");
-            auto* p6 = parameters.getRawParameterValue("vca_overeasy");
-            if (p1 && p2 && p3 && p4 && p5 && p6) {
-                cachedParams[0] = *p1;
-                cachedParams[1] = *p2;
-                cachedParams[2] = *p3;
-                cachedParams[3] = *p4;
-                cachedParams[4] = *p5;
-                cachedParams[5] = *p6; // Store OverEasy state
-            } else validParams = false;
-            break;
-        }
-        case CompressorMode::Bus:
-        {
-            auto* p1 = parameters.getRawParameterValue("bus_threshold");
-            auto* p2 = parameters.getRawParameterValue("bus_ratio");
-            auto* p3 = parameters.getRawParameterValue("bus_attack");
-            auto* p4 = parameters.getRawParameterValue("bus_release");
-            auto* p5 = parameters.getRawParameterValue("bus_makeup");
-            if (p1 && p2 && p3 && p4 && p5) {
-                cachedParams[0] = *p1;
-                // Convert discrete ratio choice to actual ratio value
-                int ratioChoice = static_cast<int>(*p2);
-                switch (ratioChoice) {
-                    case 0: cachedParams[1] = 2.0f; break;  // 2:1
-                    case 1: cachedParams[1] = 4.0f; break;  // 4:1
-                    case 2: cachedParams[1] = 10.0f; break; // 10:1
-                    default: cachedParams[1] = 2.0f; break;
-                }
-                cachedParams[2] = *p3;
-                cachedParams[3] = *p4;
-                cachedParams[4] = *p5;
-            } else validParams = false;
-            break;
-        }
+        UNIVERSAL_COMPRESSOR_STAGE_TIMER(Mix, blockSamples)
+        engines.dryBuffer.setSize(mainBuffer.getNumChannels(), mainBuffer.getNumSamples(), false, false, true);
+        for (int ch = 0; ch < mainBuffer.getNumChannels(); ++ch)
+            engines.dryBuffer.copyFrom(ch, 0, mainBuffer, ch, 0, mainBuffer.getNumSamples());
+        engines.dryDelay.process(engines.dryBuffer.getArrayOfWritePointers(), engines.dryBuffer.getNumChannels(),
+                                 engines.dryBuffer.getNumSamples(), engines.antiAliasing.getLatency());
+    }
+    else
+    {
+        engines.dryDelay.flush();
     }
     
-    if (!validParams)
-        return;
+    // Oversampling factor is fixed per prepare - 1x runs the output stages on the host block
+    const bool oversample = engines.antiAliasing.isOversamplingEnabled();
+    CompressorMode mode = snapshot.mode;
     
-    // Input metering - use peak level for accurate dB display
-    const int numChannels = buffer.getNumChannels();
-    const int numSamples = buffer.getNumSamples();
+    // Multiband runs the bands as extra engine channels, each band linked on its own,
+    // and surround buses may split each band further
+    const int numBands = engines.numBands;
+    const LinkGroups linkGroups = engines.getLinkGroups(snapshot.linkGroups, mainBuffer.getNumChannels());
     
-    // Get peak level which corresponds to actual dB values
-    float inputLevel = 0.0f;
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        float channelPeak = buffer.getMagnitude(ch, 0, numSamples);
-        inputLevel = juce::jmax(inputLevel, channelPeak);
-    }
+    // Hand the snapshot to the engines in their own parameter sets
+    typename OptoCompressor<SampleType>::Params optoParams;
+    optoParams.peakReduction = snapshot.optoPeakReduction;
+    optoParams.gain = snapshot.optoGain;
+    optoParams.limitMode = snapshot.optoLimit;
+    optoParams.stereoLink = stereoLinkAmount;
+    optoParams.linkGroups = &linkGroups;
+    
+    typename FETCompressor<SampleType>::Params fetParams;
+    fetParams.inputGainDb = snapshot.fetInput;
+    fetParams.outputGainDb = snapshot.fetOutput;
+    fetParams.attackMs = snapshot.fetAttack;
+    fetParams.releaseMs = snapshot.fetRelease;
+    fetParams.ratioIndex = snapshot.fetRatio;
+    fetParams.stereoLink = stereoLinkAmount;
+    fetParams.linkGroups = &linkGroups;
     
-    // Convert to dB - peak level gives accurate dB reading
-    float inputDb = inputLevel > 0.001f ? juce::Decibels::gainToDecibels(inputLevel) : -60.0f;
-    inputMeter.store(inputDb);
+    typename VCACompressor<SampleType>::Params vcaParams;
+    vcaParams.threshold = snapshot.vcaThreshold;
+    vcaParams.ratio = snapshot.vcaRatio;
+    vcaParams.attack = snapshot.vcaAttack;
+    vcaParams.release = snapshot.vcaRelease;
+    vcaParams.outputGain = snapshot.vcaOutput;
+    vcaParams.overEasy = snapshot.vcaOverEasy;
+    vcaParams.stereoLink = stereoLinkAmount;
+    vcaParams.linkGroups = &linkGroups;
     
-    // Process audio with reduced function call overhead
-    if (oversample && antiAliasing)
+    typename BusCompressor<SampleType>::Params busParams;
+    busParams.threshold = snapshot.busThreshold;
+    busParams.ratio = snapshot.busRatio;
+    busParams.attackIndex = snapshot.busAttack;
+    busParams.releaseIndex = snapshot.busRelease;
+    busParams.makeupGain = snapshot.busMakeup;
+    busParams.stereoLink = stereoLinkAmount;
+    busParams.linkGroups = &linkGroups;
+    
+    const int numChannels = mainBuffer.getNumChannels();
+    const int numSamples = mainBuffer.getNumSamples();
+    
+    // Input metering - peak of the incoming block, taken from the idle check above
+    MeterFrame meterFrame;
+    const float inputLevel = static_cast<float>(inputPeak);
+    meterFrame.inputDb = inputLevel > 0.001f ? juce::Decibels::gainToDecibels(inputLevel) : -60.0f;
+    
+    // Process all channels of the block at once - engines hoist their invariants per block
+    // and the feed-forward engines advance their channel detectors together in SIMD lanes.
+    // Detection and gain run at the host rate, then only the output stage that generates
+    // harmonics runs on the oversampled stream.
+    // In multiband mode the crossovers split the chunk first and the bands are summed
+    // back after the output stage
+    auto processChunk = [&](juce::dsp::AudioBlock<SampleType> channelBlock,
+                            const juce::dsp::AudioBlock<const SampleType>& keyBlock)
     {
-        juce::dsp::AudioBlock<float> block(buffer);
-        auto oversampledBlock = antiAliasing->processUp(block);
+        juce::dsp::AudioBlock<SampleType> engineBlock = channelBlock;
+        juce::dsp::AudioBlock<const SampleType> engineKeyBlock = keyBlock;
+        if (numBands > 1)
+        {
+            UNIVERSAL_COMPRESSOR_STAGE_TIMER(Crossover, static_cast<int>(channelBlock.getNumSamples()))
+            engineBlock = engines.bandSplitter.split(channelBlock, numBands, snapshot.crossoverHz);
+            if (useKey)
+                engineKeyBlock = engines.keySplitter.split(keyBlock, numBands, snapshot.crossoverHz);
+        }
         
-        const int osNumChannels = static_cast<int>(oversampledBlock.getNumChannels());
-        const int osNumSamples = static_cast<int>(oversampledBlock.getNumSamples());
+        const int numMainChannels = juce::jmax(1, static_cast<int>(channelBlock.getNumChannels()));
+        const int channelsToProcess = juce::jmin(static_cast<int>(engineBlock.getNumChannels()),
+                                                 static_cast<int>(engines.channelPointers.size()));
+        const int samplesToProcess = static_cast<int>(engineBlock.getNumSamples());
+        for (int channel = 0; channel < channelsToProcess; ++channel)
+            engines.channelPointers[static_cast<size_t>(channel)] = engineBlock.getChannelPointer(static_cast<size_t>(engines.getMainChannel(channel, numMainChannels)));
         
-        // Process with cached parameters
-        for (int channel = 0; channel < osNumChannels; ++channel)
+        // A mono key drives every channel, a stereo key pairs up with the channels,
+        // band by band in multiband mode
+        const SampleType* const* keys = nullptr;
+        if (useKey)
         {
-            float* data = oversampledBlock.getChannelPointer(static_cast<size_t>(channel));
-            
-            switch (mode)
+            const int numKeyChannels = juce::jmax(1, static_cast<int>(engineKeyBlock.getNumChannels()) / numBands);
+            for (int channel = 0; channel < channelsToProcess; ++channel)
             {
-                case CompressorMode::Opto:
-                    for (int i = 0; i < osNumSamples; ++i)
-                        data[i] = optoCompressor->process(data[i], channel, cachedParams[0], cachedParams[1], cachedParams[2] > 0.5f, true);
-                    break;
-                case CompressorMode::FET:
-                    for (int i = 0; i < osNumSamples; ++i)
-                        data[i] = fetCompressor->process(data[i], channel, cachedParams[0], cachedParams[1], cachedParams[2], cachedParams[3], static_cast<int>(cachedParams[4]), true);
-                    break;
-                case CompressorMode::VCA:
-                    for (int i = 0; i < osNumSamples; ++i)
-                        data[i] = vcaCompressor->process(data[i], channel, cachedParams[0], cachedParams[1], cachedParams[2], cachedParams[3], cachedParams[4], cachedParams[5] > 0.5f, true);
-                    break;
-                case CompressorMode::Bus:
-                    for (int i = 0; i < osNumSamples; ++i)
-                        data[i] = busCompressor->process(data[i], channel, cachedParams[0], cachedParams[1], static_cast<int>(cachedParams[2]), static_cast<int>(cachedParams[3]), cachedParams[4], true);
-                    break;
+                const int mainChannel = engines.getMainChannel(channel, numMainChannels);
+                const int keyChannel = (mainChannel / numMainChannels) * numKeyChannels + (mainChannel % numMainChannels) % numKeyChannels;
+                engines.keyPointers[static_cast<size_t>(channel)] = engineKeyBlock.getChannelPointer(static_cast<size_t>(keyChannel));
             }
+            keys = engines.keyPointers.data();
         }
         
-        antiAliasing->processDown(block);
-    }
-    else
-    {
-        // Process without oversampling
-        // No compensation needed - maintain unity gain
-        const float compensationGain = 1.0f; // Unity gain (no compensation)
+        SampleType* const* channels = engines.channelPointers.data();
+        switch (mode)
+        {
+            case CompressorMode::Opto:
+                engines.opto.processBlock(channels, keys, channelsToProcess, samplesToProcess, optoParams);
+                break;
+            case CompressorMode::FET:
+                engines.fet.processBlock(channels, keys, channelsToProcess, samplesToProcess, fetParams);
+                break;
+            case CompressorMode::VCA:
+                engines.vca.processBlock(channels, keys, channelsToProcess, samplesToProcess, vcaParams);
+                break;
+            case CompressorMode::Bus:
+                engines.bus.processBlock(channels, keys, channelsToProcess, samplesToProcess, busParams);
+                break;
+        }
         
-        for (int channel = 0; channel < numChannels; ++channel)
+        juce::dsp::AudioBlock<SampleType> saturationBlock = engineBlock;
+        if (oversample)
         {
-            float* data = buffer.getWritePointer(channel);
-            
+            UNIVERSAL_COMPRESSOR_STAGE_TIMER(Upsampling, samplesToProcess)
+            saturationBlock = engines.antiAliasing.processUp(engineBlock);
+        }
+        
+        const int saturationSamples = static_cast<int>(saturationBlock.getNumSamples());
+        for (int channel = 0; channel < channelsToProcess; ++channel)
+            engines.channelPointers[static_cast<size_t>(channel)] = saturationBlock.getChannelPointer(static_cast<size_t>(engines.getMainChannel(channel, numMainChannels)));
+        
+        {
+            UNIVERSAL_COMPRESSOR_STAGE_TIMER(Saturation, samplesToProcess)
             switch (mode)
             {
                 case CompressorMode::Opto:
-                    for (int i = 0; i < numSamples; ++i)
-                        data[i] = optoCompressor->process(data[i], channel, cachedParams[0], cachedParams[1], cachedParams[2] > 0.5f, false) * compensationGain;
+                    engines.opto.processSaturation(channels, channelsToProcess, saturationSamples);
                     break;
                 case CompressorMode::FET:
-                    for (int i = 0; i < numSamples; ++i)
-                        data[i] = fetCompressor->process(data[i], channel, cachedParams[0], cachedParams[1], cachedParams[2], cachedParams[3], static_cast<int>(cachedParams[4]), false) * compensationGain;
+                    engines.fet.processSaturation(channels, channelsToProcess, saturationSamples);
                     break;
                 case CompressorMode::VCA:
-                    for (int i = 0; i < numSamples; ++i)
-                        data[i] = vcaCompressor->process(data[i], channel, cachedParams[0], cachedParams[1], cachedParams[2], cachedParams[3], cachedParams[4], cachedParams[5] > 0.5f, false) * compensationGain;
+                    engines.vca.processSaturation(channels, channelsToProcess, saturationSamples);
                     break;
                 case CompressorMode::Bus:
-                    for (int i = 0; i < numSamples; ++i)
-                        data[i] = busCompressor->process(data[i], channel, cachedParams[0], cachedParams[1], static_cast<int>(cachedParams[2]), static_cast<int>(cachedParams[3]), cachedParams[4], false) * compensationGain;
+                    engines.bus.processSaturation(channels, channelsToProcess, saturationSamples);
                     break;
             }
         }
-    }
+        
+        if (oversample)
+        {
+            UNIVERSAL_COMPRESSOR_STAGE_TIMER(Downsampling, samplesToProcess)
+            engines.antiAliasing.processDown(engineBlock);
+        }
+        
+        if (numBands > 1)
+        {
+            UNIVERSAL_COMPRESSOR_STAGE_TIMER(Crossover, 0)  // Frames counted by the split
+            BandSplitter<SampleType>::sum(engineBlock, channelBlock, numBands);
+        }
+    };
     
-    // Output metering - use peak level for accurate dB display
-    float outputLevel = 0.0f;
-    for (int ch = 0; ch < numChannels; ++ch)
+    juce::dsp::AudioBlock<SampleType> block(mainBuffer);
+    juce::dsp::AudioBlock<const SampleType> keyBlock;
+    if (useSidechain)
+        keyBlock = juce::dsp::AudioBlock<const SampleType>(keyBuffer);
+    else if (useKey)
+        keyBlock = juce::dsp::AudioBlock<const SampleType>(engines.lookaheadKey);
+    
+    // Hosts may exceed the block size they announced, so the engine scratch and the
+    // oversampler are fed in chunks of at most the prepared size. The output peak is
+    // taken per chunk while it is still in cache rather than in a second pass over the block
+    const int chunkSize = juce::jmax(1, engines.maxBlockSize);
+    SampleType outputPeak = 0;
+    for (int start = 0; start < numSamples; start += chunkSize)
     {
-        float channelPeak = buffer.getMagnitude(ch, 0, numSamples);
-        outputLevel = juce::jmax(outputLevel, channelPeak);
+        const auto offset = static_cast<size_t>(start);
+        const int length = juce::jmin(chunkSize, numSamples - start);
+        processChunk(block.getSubBlock(offset, static_cast<size_t>(length)),
+                     useKey ? keyBlock.getSubBlock(offset, static_cast<size_t>(length)) : keyBlock);
+        
+        UNIVERSAL_COMPRESSOR_STAGE_TIMER(Metering, length)
+        outputPeak = juce::jmax(outputPeak, mainBuffer.getMagnitude(start, length));
+        
+        // Gain reduction from the active compressor, sampled at the end of every chunk.
+        // Across bands the meters show the deepest one
+        float reduction = 0.0f;
+        for (int band = 0; band < numBands; ++band)
+            reduction = juce::jmin(reduction, engines.getMeteredReduction(mode, numChannels, band * numChannels));
+        meterFrame.minGainReductionDb = start == 0 ? reduction : juce::jmin(meterFrame.minGainReductionDb, reduction);
+        meterFrame.maxGainReductionDb = start == 0 ? reduction : juce::jmax(meterFrame.maxGainReductionDb, reduction);
     }
     
-    float outputDb = outputLevel > 0.001f ? juce::Decibels::gainToDecibels(outputLevel) : -60.0f;
-    outputMeter.store(outputDb);
-    
-    // Get gain reduction from active compressor
-    float gainReduction = 0.0f;
-    switch (mode)
+    // Output metering - peak of the compressed (wet) signal, published once per block
     {
-        case CompressorMode::Opto: 
-            gainReduction = optoCompressor->getGainReduction(0);
-            if (numChannels > 1)
-                gainReduction = juce::jmin(gainReduction, optoCompressor->getGainReduction(1));
-            break;
-        case CompressorMode::FET: 
-            gainReduction = fetCompressor->getGainReduction(0);
-            if (numChannels > 1)
-                gainReduction = juce::jmin(gainReduction, fetCompressor->getGainReduction(1));
-            break;
-        case CompressorMode::VCA: 
-            gainReduction = vcaCompressor->getGainReduction(0);
-            if (numChannels > 1)
-                gainReduction = juce::jmin(gainReduction, vcaCompressor->getGainReduction(1));
-            break;
-        case CompressorMode::Bus: 
-            gainReduction = busCompressor->getGainReduction(0);
-            if (numChannels > 1)
-                gainReduction = juce::jmin(gainReduction, busCompressor->getGainReduction(1));
-            break;
+        UNIVERSAL_COMPRESSOR_STAGE_TIMER(Metering, 0)  // Frames counted per chunk
+        const float outputLevel = static_cast<float>(outputPeak);
+        meterFrame.outputDb = outputLevel > 0.001f ? juce::Decibels::gainToDecibels(outputLevel) : -60.0f;
+        publishMeters(meterFrame);
+        
+        for (int band = 0; band < MAX_BANDS; ++band)
+            bandGrMeters[static_cast<size_t>(band)].store(band < numBands ? engines.getMeteredReduction(mode, numChannels, band * numChannels) : 0.0f);
     }
-    grMeter.store(gainReduction);
-    
-    // Update the gain reduction parameter for DAW display
-    if (auto* grParam = parameters.getRawParameterValue("gr_meter"))
-        *grParam = gainReduction;
     
     // Apply mix control for parallel compression
-    if (mixAmount < 1.0f && dryBuffer.getNumChannels() > 0)
+    if (mixAmount < 1.0f)
     {
+        UNIVERSAL_COMPRESSOR_STAGE_TIMER(Mix, 0)  // Frames counted by the dry copy
+        
         // Blend dry and wet signals
         for (int ch = 0; ch < numChannels; ++ch)
         {
-            float* wet = buffer.getWritePointer(ch);
-            const float* dry = dryBuffer.getReadPointer(ch);
+            SampleType* wet = mainBuffer.getWritePointer(ch);
+            const SampleType* dry = engines.dryBuffer.getReadPointer(ch);
             
             for (int i = 0; i < numSamples; ++i)
             {
@@ -1876,45 +3799,148 @@ void UniversalCompressor::processBlock(juce::AudioBuffer<float>& buffer, juce::M
     }
 }
 
-void UniversalCompressor::processBlock(juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midiMessages)
+juce::AudioProcessorEditor* UniversalCompressor::createEditor()
+{
+    #if UNIVERSAL_COMPRESSOR_HEADLESS
+    return nullptr;
+    #else
+    // Use the enhanced analog-style editor
+    return new EnhancedCompressorEditor(*this);
+    #endif
+}
+
+void UniversalCompressor::publishMeters(const MeterFrame& frame)
 {
-    // Convert double to float, process, then convert back
-    juce::AudioBuffer<float> floatBuffer(buffer.getNumChannels(), buffer.getNumSamples());
+    // Latest values for simple polling
+    inputMeter.store(frame.inputDb);
+    outputMeter.store(frame.outputDb);
+    grMeter.store(frame.minGainReductionDb);  // Also what the host-facing gr_meter reports
     
-    // Convert double to float
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    // Queue the frame for the editor's history. With no editor draining the queue it
+    // fills up and further frames are dropped - the audio thread never waits
+    int start1, size1, start2, size2;
+    meterFifo.prepareToWrite(1, start1, size1, start2, size2);
+    if (size1 > 0)
     {
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
-        {
-            floatBuffer.setSample(ch, i, static_cast<float>(buffer.getSample(ch, i)));
-        }
+        meterHistory[static_cast<size_t>(start1)] = frame;
+        meterFifo.finishedWrite(1);
     }
+}
+
+float UniversalCompressor::getBandGainReduction(int band) const
+{
+    if (band < 0 || band >= MAX_BANDS)
+        return 0.0f;
+    return bandGrMeters[static_cast<size_t>(band)].load();
+}
+
+int UniversalCompressor::readMeterHistory(MeterFrame* destination, int maxFrames)
+{
+    if (destination == nullptr || maxFrames <= 0)
+        return 0;
+    
+    int start1, size1, start2, size2;
+    meterFifo.prepareToRead(maxFrames, start1, size1, start2, size2);
+    std::copy_n(meterHistory.begin() + start1, size1, destination);
+    std::copy_n(meterHistory.begin() + start2, size2, destination + size1);
+    meterFifo.finishedRead(size1 + size2);
+    return size1 + size2;
+}
+
+void UniversalCompressor::CpuLoadHistogram::add(juce::int64 ticks, double blockSeconds) noexcept
+{
+    if (ticks < 0 || blockSeconds <= 0.0)
+        return;
+    
+    const double load = static_cast<double>(ticks) * secondsPerTick / blockSeconds;
+    const auto loadPpm = static_cast<juce::uint64>(load * 1.0e6);
+    const auto elapsed = static_cast<juce::uint64>(ticks);
+    
+    // Bin 0 holds everything up to 0.01% load, the last bin everything above its range
+    const int bin = load > 1.0e-4 ? juce::jmin(NUM_BINS - 1, static_cast<int>(std::log2(load * 1.0e4) * 16.0)) : 0;
+    bins[static_cast<size_t>(bin)].fetch_add(1, std::memory_order_relaxed);
+    totalTicks.fetch_add(elapsed, std::memory_order_relaxed);
+    totalLoadPpm.fetch_add(loadPpm, std::memory_order_relaxed);
+    
+    // The audio thread is the only writer, so a plain compare is enough for the maxima
+    if (elapsed > maxTicks.load(std::memory_order_relaxed))
+        maxTicks.store(elapsed, std::memory_order_relaxed);
+    if (loadPpm > maxLoadPpm.load(std::memory_order_relaxed))
+        maxLoadPpm.store(loadPpm, std::memory_order_relaxed);
+    
+    // Counted last, so readers never see more blocks than the totals include
+    numBlocks.fetch_add(1, std::memory_order_release);
+}
+
+UniversalCompressor::CpuStatistics UniversalCompressor::CpuLoadHistogram::getStatistics() const noexcept
+{
+    CpuStatistics statistics;
+    statistics.numBlocks = static_cast<int>(numBlocks.load(std::memory_order_acquire));
+    if (statistics.numBlocks == 0)
+        return statistics;
+    
+    const double microsecondsPerTick = secondsPerTick * 1.0e6;
+    statistics.meanMicroseconds = static_cast<double>(totalTicks.load(std::memory_order_relaxed)) * microsecondsPerTick / statistics.numBlocks;
+    statistics.maxMicroseconds = static_cast<double>(maxTicks.load(std::memory_order_relaxed)) * microsecondsPerTick;
+    statistics.meanLoadPercent = static_cast<double>(totalLoadPpm.load(std::memory_order_relaxed)) * 1.0e-4 / statistics.numBlocks;
+    statistics.maxLoadPercent = static_cast<double>(maxLoadPpm.load(std::memory_order_relaxed)) * 1.0e-4;
     
-    // Process the float buffer
-    processBlock(floatBuffer, midiMessages);
+    // Upper edge of the bin the 99th percentile block falls in
+    juce::uint64 binTotal = 0;
+    for (const auto& bin : bins)
+        binTotal += bin.load(std::memory_order_relaxed);
     
-    // Convert back to double
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    const auto target = static_cast<juce::uint64>(std::ceil(static_cast<double>(binTotal) * 0.99));
+    juce::uint64 count = 0;
+    for (int i = 0; i < NUM_BINS; ++i)
     {
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        count += bins[static_cast<size_t>(i)].load(std::memory_order_relaxed);
+        if (count >= target)
         {
-            buffer.setSample(ch, i, static_cast<double>(floatBuffer.getSample(ch, i)));
+            statistics.p99LoadPercent = juce::jmin(0.01 * std::exp2((i + 1) / 16.0), statistics.maxLoadPercent);
+            break;
         }
     }
+    return statistics;
 }
 
-juce::AudioProcessorEditor* UniversalCompressor::createEditor()
+void UniversalCompressor::CpuLoadHistogram::reset() noexcept
 {
-    // Use the enhanced analog-style editor
-    return new EnhancedCompressorEditor(*this);
+    // Not atomic as a whole - a block finishing meanwhile may be half counted
+    numBlocks.store(0, std::memory_order_relaxed);
+    for (auto& bin : bins)
+        bin.store(0, std::memory_order_relaxed);
+    totalTicks.store(0, std::memory_order_relaxed);
+    maxTicks.store(0, std::memory_order_relaxed);
+    totalLoadPpm.store(0, std::memory_order_relaxed);
+    maxLoadPpm.store(0, std::memory_order_relaxed);
 }
 
+#if UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+const char* UniversalCompressor::getStageName(ProfiledStage stage) noexcept
+{
+    switch (stage)
+    {
+        case ProfiledStage::Lookahead:     return "lookahead";
+        case ProfiledStage::Crossover:     return "crossover";
+        case ProfiledStage::Upsampling:    return "upsampling";
+        case ProfiledStage::Detector:      return "detector";
+        case ProfiledStage::GainEnvelope:  return "gain_envelope";
+        case ProfiledStage::Saturation:    return "saturation";
+        case ProfiledStage::Downsampling:  return "downsampling";
+        case ProfiledStage::Mix:           return "mix";
+        case ProfiledStage::Metering:      return "metering";
+        case ProfiledStage::NumStages:     break;
+    }
+    return "";
+}
+#endif
+
 CompressorMode UniversalCompressor::getCurrentMode() const
 {
-    auto* modeParam = parameters.getRawParameterValue("mode");
-    if (modeParam)
+    if (parameterHandles.mode != nullptr)
     {
-        int mode = static_cast<int>(*modeParam);
+        int mode = static_cast<int>(parameterHandles.mode->load(std::memory_order_relaxed));
         return static_cast<CompressorMode>(juce::jlimit(0, 3, mode));
     }
     return CompressorMode::Opto; // Default fallback
@@ -1922,19 +3948,20 @@ CompressorMode UniversalCompressor::getCurrentMode() const
 
 double UniversalCompressor::getLatencyInSamples() const
 {
-    // No latency since main path oversampling is disabled
-    return 0.0;
+    // Oversampling plus lookahead, as last reported to the host
+    return static_cast<double>(getLatencySamples());
 }
 
 double UniversalCompressor::getTailLengthSeconds() const
 {
-    // Account for lookahead delay if implemented
+    // The delayed audio keeps coming out for the latency after the input stops
     return currentSampleRate > 0 ? getLatencyInSamples() / currentSampleRate : 0.0;
 }
 
 void UniversalCompressor::getStateInformation(juce::MemoryBlock& destData)
 {
     auto state = parameters.copyState();
+    GainReductionMeterParameter::removeFromState(state);
     std::unique_ptr<juce::XmlElement> xml(state.createXml());
     copyXmlToBinary(*xml, destData);
 }
@@ -1945,7 +3972,11 @@ void UniversalCompressor::setStateInformation(const void* data, int sizeInBytes)
     
     if (xmlState.get() != nullptr)
         if (xmlState->hasTagName(parameters.state.getType()))
-            parameters.replaceState(juce::ValueTree::fromXml(*xmlState));
+        {
+            auto state = juce::ValueTree::fromXml(*xmlState);
+            GainReductionMeterParameter::removeFromState(state);
+            parameters.replaceState(state);
+        }
 }
 
 #if JucePlugin_Build_LV2 && 0  // Disabled - requires Cairo library
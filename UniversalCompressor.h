@@ -13,7 +13,9 @@ enum class CompressorMode : int
     Bus = 3      // SSL Bus style compressor
 };
 
-class UniversalCompressor : public juce::AudioProcessor
+class UniversalCompressor : public juce::AudioProcessor,
+                            private juce::AudioProcessorValueTreeState::Listener,
+                            private juce::AsyncUpdater
 {
 public:
     UniversalCompressor();
@@ -23,9 +25,17 @@ public:
     void releaseResources() override;
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
     void processBlock(juce::AudioBuffer<double>&, juce::MidiBuffer&) override;
+    bool supportsDoublePrecisionProcessing() const override { return true; }
+    bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
+    void setNonRealtime(bool isNonRealtime) noexcept override;
 
+    // Headless builds (the batch renderer) leave the editor out
     juce::AudioProcessorEditor* createEditor() override;
+    #if UNIVERSAL_COMPRESSOR_HEADLESS
+    bool hasEditor() const override { return false; }
+    #else
     bool hasEditor() const override { return true; }
+    #endif
 
     const juce::String getName() const override { return "Universal Compressor"; }
     bool acceptsMidi() const override { return false; }
@@ -48,6 +58,73 @@ public:
     float getOutputLevel() const { return outputMeter.load(); }
     float getGainReduction() const { return grMeter.load(); }
     
+    // Meter history: one frame per processed block, queued lock-free by the audio
+    // thread so a slower UI timer still sees every peak between its polls
+    struct MeterFrame
+    {
+        float inputDb = -60.0f;              // Peak input level of the block
+        float outputDb = -60.0f;             // Peak output level of the block
+        float minGainReductionDb = 0.0f;     // Deepest reduction within the block
+        float maxGainReductionDb = 0.0f;     // Shallowest reduction within the block
+    };
+    static constexpr int METER_HISTORY_SIZE = 1024;
+    
+    // Single consumer only (the editor) - returns the number of frames copied, oldest first
+    int readMeterHistory(MeterFrame* destination, int maxFrames);
+    
+    // Multiband mode - gain reduction of each band, 0 for bands that are not in use
+    static constexpr int MAX_BANDS = 4;
+    float getBandGainReduction(int band) const;
+    
+    // CPU time of each processBlock call, gathered while timing is enabled. Load is
+    // the time taken as a share of the block's duration, so 100% misses the deadline.
+    // Disabled, the audio thread only checks the flag. Safe to read from any thread
+    struct CpuStatistics
+    {
+        int numBlocks = 0;
+        double meanMicroseconds = 0.0;       // Per block
+        double maxMicroseconds = 0.0;
+        double meanLoadPercent = 0.0;
+        double p99LoadPercent = 0.0;         // Resolution is about 4% of the value
+        double maxLoadPercent = 0.0;
+    };
+    void setCpuTimingEnabled(bool shouldTime) noexcept { cpuTimingEnabled.store(shouldTime, std::memory_order_relaxed); }
+    bool isCpuTimingEnabled() const noexcept { return cpuTimingEnabled.load(std::memory_order_relaxed); }
+    CpuStatistics getCpuStatistics() const noexcept { return cpuLoad.getStatistics(); }
+    void resetCpuStatistics() noexcept { cpuLoad.reset(); }
+    
+    #if UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+    // Time spent in each stage of the chain, per mode, compiled in with the CMake option
+    // UNIVERSAL_COMPRESSOR_STAGE_TIMERS. Samples are host-rate frames, so time per sample
+    // compares across oversampling factors. Not synchronised with the audio thread - read
+    // and reset only while processing is stopped
+    enum class ProfiledStage : int
+    {
+        Lookahead,       // Key copy and audio delay
+        Crossover,       // Band split and sum in multiband mode
+        Upsampling,
+        Detector,        // Feed-forward level detection and stereo link (VCA, Bus)
+        GainEnvelope,    // Gain computer and envelope, with the detection of the feedback modes (Opto, FET)
+        Saturation,      // Harmonics, output transformer and output gain at the oversampled rate
+        Downsampling,
+        Mix,             // Dry copy and parallel blend
+        Metering,        // Output peak, gain reduction and meter publishing
+        NumStages
+    };
+    static constexpr int NUM_PROFILED_STAGES = static_cast<int>(ProfiledStage::NumStages);
+    static constexpr int NUM_PROFILED_MODES = 4;
+    struct StageTiming
+    {
+        juce::uint64 ticks = 0;      // High resolution ticks
+        juce::uint64 calls = 0;
+        juce::uint64 samples = 0;
+    };
+    using StageTimings = std::array<std::array<StageTiming, NUM_PROFILED_STAGES>, NUM_PROFILED_MODES>;
+    const StageTimings& getStageTimings() const noexcept { return stageTimings; }
+    void resetStageTimings() noexcept { stageTimings = StageTimings{}; }
+    static const char* getStageName(ProfiledStage stage) noexcept;
+    #endif
+    
     // Parameter access
     juce::AudioProcessorValueTreeState& getParameters() { return parameters; }
     CompressorMode getCurrentMode() const;
@@ -58,35 +135,172 @@ public:
     #endif
 
 private:
-    // Core DSP classes
-    class OptoCompressor;
-    class FETCompressor;
-    class VCACompressor;
-    class BusCompressor;
-    class AntiAliasing;
+    // Core DSP classes, templated on the processing precision
+    template <typename SampleType> class OptoCompressor;
+    template <typename SampleType> class FETCompressor;
+    template <typename SampleType> class VCACompressor;
+    template <typename SampleType> class BusCompressor;
+    template <typename SampleType> class AntiAliasing;
+    template <typename SampleType> class LookaheadDelay;
+    template <typename SampleType> class BandSplitter;
+    template <typename SampleType> struct EngineSet;
+    
+    // Metering - declared before the parameter tree, whose gr_meter reads grMeter
+    std::atomic<float> inputMeter{-60.0f};
+    std::atomic<float> outputMeter{-60.0f};
+    std::atomic<float> grMeter{0.0f};
+    std::array<std::atomic<float>, MAX_BANDS> bandGrMeters{};
     
     // Parameter state
     juce::AudioProcessorValueTreeState parameters;
     
-    // DSP components
-    std::unique_ptr<OptoCompressor> optoCompressor;
-    std::unique_ptr<FETCompressor> fetCompressor;
-    std::unique_ptr<VCACompressor> vcaCompressor;
-    std::unique_ptr<BusCompressor> busCompressor;
-    std::unique_ptr<AntiAliasing> antiAliasing;
+    // Raw parameter handles, resolved once in the constructor so the audio
+    // thread never looks a parameter up by its string ID
+    struct ParameterHandles
+    {
+        std::atomic<float>* mode = nullptr;
+        std::atomic<float>* bypass = nullptr;
+        std::atomic<float>* stereoLink = nullptr;
+        std::atomic<float>* linkGroups = nullptr;
+        std::atomic<float>* mix = nullptr;
+        std::atomic<float>* sidechainEnable = nullptr;
+        std::atomic<float>* lookahead = nullptr;
+        
+        std::atomic<float>* oversampling = nullptr;
+        std::atomic<float>* oversamplingOffline = nullptr;
+        std::atomic<float>* oversamplingFilter = nullptr;
+        std::atomic<float>* oversamplingMaxRate = nullptr;
+        std::atomic<float>* multiband = nullptr;
+        std::atomic<float>* crossoverLow = nullptr;
+        std::atomic<float>* crossoverMid = nullptr;
+        std::atomic<float>* crossoverHigh = nullptr;
+        
+        std::atomic<float>* optoPeakReduction = nullptr;
+        std::atomic<float>* optoGain = nullptr;
+        std::atomic<float>* optoLimit = nullptr;
+        
+        std::atomic<float>* fetInput = nullptr;
+        std::atomic<float>* fetOutput = nullptr;
+        std::atomic<float>* fetAttack = nullptr;
+        std::atomic<float>* fetRelease = nullptr;
+        std::atomic<float>* fetRatio = nullptr;
+        
+        std::atomic<float>* vcaThreshold = nullptr;
+        std::atomic<float>* vcaRatio = nullptr;
+        std::atomic<float>* vcaAttack = nullptr;
+        std::atomic<float>* vcaRelease = nullptr;
+        std::atomic<float>* vcaOutput = nullptr;
+        std::atomic<float>* vcaOverEasy = nullptr;
+        
+        std::atomic<float>* busThreshold = nullptr;
+        std::atomic<float>* busRatio = nullptr;
+        std::atomic<float>* busAttack = nullptr;
+        std::atomic<float>* busRelease = nullptr;
+        std::atomic<float>* busMakeup = nullptr;
+        
+        bool allResolved = false;
+    };
+    ParameterHandles parameterHandles;
+    
+    // Plain copy of every parameter value, taken once at the top of each block
+    // so the engines see one consistent set for the whole block
+    struct ParameterSnapshot
+    {
+        CompressorMode mode = CompressorMode::Opto;
+        bool bypass = false;
+        float stereoLink = 1.0f;  // 0-1
+        int linkGroups = 0;       // All channels, all but LFE, front / surround / height
+        float mix = 1.0f;         // 0-1
+        bool sidechainEnable = false;
+        float lookaheadMs = 0.0f;
+        std::array<float, MAX_BANDS - 1> crossoverHz{};  // Low to high
+        
+        float optoPeakReduction = 0.0f;
+        float optoGain = 0.0f;    // dB
+        bool optoLimit = false;
+        
+        float fetInput = 0.0f;
+        float fetOutput = 0.0f;
+        float fetAttack = 0.0f;
+        float fetRelease = 0.0f;
+        int fetRatio = 0;
+        
+        float vcaThreshold = 0.0f;
+        float vcaRatio = 1.0f;
+        float vcaAttack = 0.0f;
+        float vcaRelease = 0.0f;
+        float vcaOutput = 0.0f;
+        bool vcaOverEasy = false;
+        
+        float busThreshold = 0.0f;
+        float busRatio = 2.0f;
+        int busAttack = 0;
+        int busRelease = 0;
+        float busMakeup = 0.0f;
+    };
     
-    // Metering
-    std::atomic<float> inputMeter{-60.0f};
-    std::atomic<float> outputMeter{-60.0f};
-    std::atomic<float> grMeter{0.0f};
+    void resolveParameterHandles();
+    ParameterSnapshot takeParameterSnapshot() const;
     
-    // Stereo linking
-    float linkedGainReduction[2] = {0.0f, 0.0f};
-    // stereoLinkAmount now controlled by parameter
+    // Latency reporting - lookahead is converted at the current host rate
+    int getLookaheadSamples(float lookaheadMs) const;
+    void updateLatency();
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    
+    // The listener may run on any thread, so it only flags a structural change and
+    // the engines are rebuilt here on the message thread
+    void handleAsyncUpdate() override;
+    std::atomic<bool> enginesNeedRebuild{false};
+    
+    // DSP components - one set per precision so 64-bit hosts run natively
+    std::unique_ptr<EngineSet<float>> floatEngines;
+    std::unique_ptr<EngineSet<double>> doubleEngines;
+    
+    void prepareAllEngines();
+    void reprepareEngines();
+    template <typename SampleType>
+    void prepareEngines(EngineSet<SampleType>& engines, double sampleRate, int samplesPerBlock);
+    template <typename SampleType>
+    void processEngines(juce::AudioBuffer<SampleType>& buffer, EngineSet<SampleType>& engines);
+    
+    // Meter history ring - the audio thread is the only writer, the editor the only reader
+    juce::AbstractFifo meterFifo{METER_HISTORY_SIZE};
+    std::array<MeterFrame, METER_HISTORY_SIZE> meterHistory;
+    
+    void publishMeters(const MeterFrame& frame);
+    
+    // Per-block load histogram - the audio thread only adds to atomics, so readers
+    // never block it. Bins are log spaced, 16 per octave from 0.01% load
+    class CpuLoadHistogram
+    {
+    public:
+        void add(juce::int64 ticks, double blockSeconds) noexcept;
+        CpuStatistics getStatistics() const noexcept;
+        void reset() noexcept;
+        
+    private:
+        static constexpr int NUM_BINS = 320;
+        const double secondsPerTick = 1.0 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+        std::array<std::atomic<juce::uint32>, NUM_BINS> bins{};
+        std::atomic<juce::uint32> numBlocks{0};
+        std::atomic<juce::uint64> totalTicks{0};
+        std::atomic<juce::uint64> maxTicks{0};
+        std::atomic<juce::uint64> totalLoadPpm{0};  // Load in parts per million
+        std::atomic<juce::uint64> maxLoadPpm{0};
+    };
+    std::atomic<bool> cpuTimingEnabled{false};
+    CpuLoadHistogram cpuLoad;
+    
+    #if UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+    StageTimings stageTimings{};
+    #endif
     
     // Processing state
     double currentSampleRate{0.0};  // Set by prepareToPlay from DAW
     int currentBlockSize{0};  // Set by prepareToPlay from DAW
+    int oversamplingStages{1};  // Power of two the engines run at, resolved in prepareAllEngines
+    bool oversamplingLinearPhase{false};
+    int multibandBands{1};  // Bands the engines run, 1 = full band, resolved in prepareAllEngines
     
     // Lookup tables for performance optimization
     class LookupTables
@@ -99,6 +313,7 @@ private:
         void initialize();
         inline float fastExp(float x) const;
         inline float fastLog(float x) const;
+        inline float envelopeCoefficient(float timeSeconds, float sampleRate) const;
     };
     std::unique_ptr<LookupTables> lookupTables;
     
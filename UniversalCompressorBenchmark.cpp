@@ -0,0 +1,283 @@
+/*
+  UniversalCompressorBenchmark
+  DSP micro-benchmark - times processBlock for every mode over synthetic program
+  material and writes the results as JSON.
+  
+  UniversalCompressorBenchmark [options]
+    --output <file>           Write the JSON here instead of stdout
+    --seconds <s>             Audio rendered per measurement (default: 2)
+    --modes <list>            Opto,FET,VCA,Bus (default: all)
+    --configs <list>          engine,oversampled,full (default: all)
+    --block-sizes <list>      Default: 16,64,256,1024,4096
+    --sample-rates <list>     Default: 44100,96000
+    --channels <list>         Default: 1,2,6
+    --double                  Process in double precision
+    --stage-profile <file>    Time per stage and mode as CSV, or JSON for a .json file.
+                              Needs a build with UNIVERSAL_COMPRESSOR_STAGE_TIMERS, which
+                              also adds each run's stages to the results
+  
+  Configurations, so engine and oversampler cost can be told apart:
+    engine        1x oversampling - detection, gain and output stage only
+    oversampled   2x oversampling, the plugin default
+    full          4x oversampling, 5 ms lookahead, 70% mix, 3-band multiband
+*/
+
+#include "UniversalCompressorTools.h"
+#include <algorithm>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    struct BenchmarkConfig
+    {
+        const char* name;
+        int oversampling;       // Choice index - 1x, 2x, 4x, 8x
+        float lookaheadMs;
+        float mix;              // Percent
+        int multiband;          // Choice index - off, 2, 3, 4 bands
+    };
+    
+    const BenchmarkConfig configs[] = {
+        { "engine",      0, 0.0f, 100.0f, 0 },
+        { "oversampled", 1, 0.0f, 100.0f, 0 },
+        { "full",        2, 5.0f, 70.0f,  2 }
+    };
+    
+    const char* const modeNames[] = { "Opto", "FET", "VCA", "Bus" };
+    
+    #if UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+    // Stage timings of every measured pass, for --stage-profile
+    UniversalCompressor::StageTimings profiledStages{};
+    #endif
+    
+    struct Run
+    {
+        int mode = 0;
+        const BenchmarkConfig* config = nullptr;
+        double sampleRate = 48000.0;
+        int blockSize = 512;
+        int numChannels = 2;
+    };
+    
+    // Sets every mode to compress the program material by several dB, so the gain
+    // stages are doing real work
+    void setBenchmarkParameters(UniversalCompressor& processor, const Run& run)
+    {
+        using UniversalCompressorTools::setParameter;
+        setParameter(processor, "mode", static_cast<float>(run.mode));
+        setParameter(processor, "oversampling", static_cast<float>(run.config->oversampling));
+        setParameter(processor, "lookahead", run.config->lookaheadMs);
+        setParameter(processor, "mix", run.config->mix);
+        setParameter(processor, "multiband", static_cast<float>(run.config->multiband));
+        
+        setParameter(processor, "opto_peak_reduction", 60.0f);
+        setParameter(processor, "fet_input", 20.0f);
+        setParameter(processor, "fet_output", -6.0f);
+        setParameter(processor, "vca_threshold", -20.0f);
+        setParameter(processor, "vca_ratio", 4.0f);
+        setParameter(processor, "bus_threshold", -18.0f);
+        setParameter(processor, "bus_ratio", 1.0f);
+    }
+    
+    double getPercentile(const std::vector<double>& sorted, double percentile)
+    {
+        if (sorted.empty())
+            return 0.0;
+        const auto index = static_cast<size_t>(juce::jlimit(0.0, 1.0, percentile / 100.0) * static_cast<double>(sorted.size() - 1) + 0.5);
+        return sorted[index];
+    }
+    
+    // Renders the material once to warm up, then again timing every block.
+    // Returns the JSON result, or a void var when the run cannot be set up
+    template <typename SampleType>
+    juce::var runBenchmark(const Run& run, double seconds)
+    {
+        UniversalCompressor processor;
+        if (!UniversalCompressorTools::setMainLayout(processor, run.numChannels))
+            return {};
+        
+        setBenchmarkParameters(processor, run);
+        processor.setProcessingPrecision(std::is_same<SampleType, double>::value ? juce::AudioProcessor::doublePrecision
+                                                                                  : juce::AudioProcessor::singlePrecision);
+        processor.setRateAndBufferSizeDetails(run.sampleRate, run.blockSize);
+        processor.prepareToPlay(run.sampleRate, run.blockSize);
+        
+        const int length = juce::jmax(run.blockSize, static_cast<int>(seconds * run.sampleRate));
+        juce::AudioBuffer<SampleType> material(run.numChannels, length);
+        UniversalCompressorTools::fillProgramMaterial(material, run.sampleRate);
+        
+        juce::AudioBuffer<SampleType> block(run.numChannels, run.blockSize);
+        juce::MidiBuffer midi;
+        std::vector<double> blockNsPerSample;
+        blockNsPerSample.reserve(static_cast<size_t>(length / run.blockSize + 1));
+        
+        const double nsPerTick = 1.0e9 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+        double totalNs = 0.0;
+        
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            const bool measure = pass == 1;
+            #if UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+            processor.resetStageTimings();  // Keep the measured pass only
+            #endif
+            
+            for (int start = 0; start + run.blockSize <= length; start += run.blockSize)
+            {
+                for (int channel = 0; channel < run.numChannels; ++channel)
+                    block.copyFrom(channel, 0, material, channel, start, run.blockSize);
+                
+                const auto startTicks = juce::Time::getHighResolutionTicks();
+                processor.processBlock(block, midi);
+                const double elapsedNs = static_cast<double>(juce::Time::getHighResolutionTicks() - startTicks) * nsPerTick;
+                
+                if (measure)
+                {
+                    blockNsPerSample.push_back(elapsedNs / run.blockSize);
+                    totalNs += elapsedNs;
+                }
+            }
+        }
+        
+        processor.releaseResources();
+        
+        const double measuredSamples = static_cast<double>(blockNsPerSample.size()) * run.blockSize;
+        const double audioNs = measuredSamples / run.sampleRate * 1.0e9;
+        std::sort(blockNsPerSample.begin(), blockNsPerSample.end());
+        
+        auto* result = new juce::DynamicObject();
+        result->setProperty("mode", modeNames[run.mode]);
+        result->setProperty("config", run.config->name);
+        result->setProperty("precision", std::is_same<SampleType, double>::value ? "double" : "float");
+        result->setProperty("sampleRate", run.sampleRate);
+        result->setProperty("blockSize", run.blockSize);
+        result->setProperty("channels", run.numChannels);
+        result->setProperty("blocks", static_cast<int>(blockNsPerSample.size()));
+        result->setProperty("nsPerSample", measuredSamples > 0.0 ? totalNs / measuredSamples : 0.0);
+        result->setProperty("realtimeFactor", totalNs > 0.0 ? audioNs / totalNs : 0.0);
+        result->setProperty("p50NsPerSample", getPercentile(blockNsPerSample, 50.0));
+        result->setProperty("p90NsPerSample", getPercentile(blockNsPerSample, 90.0));
+        result->setProperty("p99NsPerSample", getPercentile(blockNsPerSample, 99.0));
+        result->setProperty("maxNsPerSample", blockNsPerSample.empty() ? 0.0 : blockNsPerSample.back());
+        
+        #if UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+        result->setProperty("stages", UniversalCompressorTools::getStageProfile(processor.getStageTimings()));
+        UniversalCompressorTools::addStageTimings(profiledStages, processor.getStageTimings());
+        #endif
+        return juce::var(result);
+    }
+    
+    // Comma separated option value, or the defaults when the option is not given
+    juce::StringArray getList(juce::ArgumentList& args, const char* option, const char* defaults)
+    {
+        auto value = args.removeValueForOption(option);
+        if (value.isEmpty())
+            value = defaults;
+        return juce::StringArray::fromTokens(value, ",", {});
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Processor parameters start timers, so a message manager has to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    
+    juce::ArgumentList args(argc, argv);
+    const auto outputFile = args.removeValueForOption("--output|-o");
+    const auto secondsOption = args.removeValueForOption("--seconds");
+    const double seconds = secondsOption.isNotEmpty() ? juce::jmax(0.01, secondsOption.getDoubleValue()) : 2.0;
+    const bool useDouble = args.removeOptionIfFound("--double");
+    const auto stageProfileFile = args.removeValueForOption("--stage-profile");
+    
+    const auto modes = getList(args, "--modes", "Opto,FET,VCA,Bus");
+    const auto configNames = getList(args, "--configs", "engine,oversampled,full");
+    const auto blockSizes = getList(args, "--block-sizes", "16,64,256,1024,4096");
+    const auto sampleRates = getList(args, "--sample-rates", "44100,96000");
+    auto channelCounts = getList(args, "--channels", "1,2,6");
+    
+    for (int i = channelCounts.size(); --i >= 0;)
+    {
+        if (UniversalCompressorTools::getLayoutForChannels(channelCounts[i].getIntValue()).isDisabled())
+        {
+            std::cerr << "Skipping " << channelCounts[i] << " channels - no supported layout" << std::endl;
+            channelCounts.remove(i);
+        }
+    }
+    
+    if (args.size() > 0)
+    {
+        std::cerr << "Unknown argument " << args.arguments.getFirst().text << std::endl;
+        return 1;
+    }
+    
+    #if ! UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+    if (stageProfileFile.isNotEmpty())
+    {
+        std::cerr << "--stage-profile needs a build with UNIVERSAL_COMPRESSOR_STAGE_TIMERS=ON" << std::endl;
+        return 1;
+    }
+    #endif
+    
+    juce::Array<juce::var> results;
+    for (int mode = 0; mode < 4; ++mode)
+    {
+        if (!modes.contains(modeNames[mode], true))
+            continue;
+        
+        for (const auto& config : configs)
+        {
+            if (!configNames.contains(config.name, true))
+                continue;
+            
+            for (const auto& sampleRate : sampleRates)
+                for (const auto& channels : channelCounts)
+                    for (const auto& blockSize : blockSizes)
+                    {
+                        Run run;
+                        run.mode = mode;
+                        run.config = &config;
+                        run.sampleRate = sampleRate.getDoubleValue();
+                        run.blockSize = juce::jlimit(1, 65536, blockSize.getIntValue());
+                        run.numChannels = channels.getIntValue();
+                        
+                        auto result = useDouble ? runBenchmark<double>(run, seconds) : runBenchmark<float>(run, seconds);
+                        if (result.isVoid())
+                            continue;
+                        
+                        std::cerr << modeNames[mode] << " " << config.name << " " << run.sampleRate << " Hz "
+                                  << run.numChannels << " ch " << run.blockSize << " samples: "
+                                  << static_cast<double>(result["nsPerSample"]) << " ns/sample" << std::endl;
+                        results.add(result);
+                    }
+        }
+    }
+    
+    auto* report = new juce::DynamicObject();
+    report->setProperty("benchmark", "UniversalCompressor");
+    report->setProperty("secondsPerRun", seconds);
+    report->setProperty("results", results);
+    const auto json = juce::JSON::toString(juce::var(report));
+    
+    #if UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+    if (stageProfileFile.isNotEmpty()
+        && !UniversalCompressorTools::writeStageProfile(profiledStages, juce::File::getCurrentWorkingDirectory().getChildFile(stageProfileFile)))
+    {
+        std::cerr << "Cannot write " << stageProfileFile << std::endl;
+        return 1;
+    }
+    #endif
+    
+    if (outputFile.isEmpty())
+    {
+        std::cout << json << std::endl;
+        return 0;
+    }
+    
+    if (!juce::File::getCurrentWorkingDirectory().getChildFile(outputFile).replaceWithText(json))
+    {
+        std::cerr << "Cannot write " << outputFile << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,436 @@
+/*
+  UniversalCompressorGoldenTest
+  Golden-output null test - renders reference signals through every mode and a set
+  of parameter corners and compares the result against stored golden renders.
+  
+  UniversalCompressorGoldenTest [options]
+    --golden-dir <dir>    Golden renders (default: golden)
+    --update              Record the current renders as the new goldens
+    --filter <text>       Only cases whose name contains text
+    --report <file>       Also write the per-case deviations as JSON
+  
+  Exit code 0 when every case is inside its mode's tolerance, 1 on a deviation or
+  a missing golden, 77 (skipped) when the golden directory does not exist yet.
+*/
+
+#include "UniversalCompressorTools.h"
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+namespace
+{
+    constexpr double SAMPLE_RATE = 48000.0;
+    constexpr int BLOCK_SIZE = 256;
+    constexpr int NUM_CHANNELS = 2;
+    constexpr int CASE_LENGTH = 48000;          // One second per case
+    constexpr int GOLDEN_MAGIC = 0x31474355;    // "UCG1"
+    constexpr int EXIT_SKIPPED = 77;
+    
+    // Largest deviation each mode may show against its goldens. Audio is measured
+    // in dB relative to full scale, the gain reduction curve in dB
+    struct Tolerance
+    {
+        float maxErrorDb;
+        float rmsErrorDb;
+        float gainReductionDb;
+    };
+    
+    const Tolerance tolerances[] = {
+        { -70.0f, -90.0f, 0.10f },  // Opto - feedback cell and tube stage amplify small differences
+        { -70.0f, -90.0f, 0.10f },  // FET - fast attack and transformer stage
+        { -80.0f, -100.0f, 0.05f }, // VCA
+        { -80.0f, -100.0f, 0.05f }  // Bus
+    };
+    
+    const char* const modeNames[] = { "Opto", "FET", "VCA", "Bus" };
+    
+    //==============================================================================
+    // Reference signals, mono material that the right channel carries at a lower
+    // level so the stereo link has something to do
+    enum class Signal { Sine, QuietSine, Sweep, DrumLoop, Silence, DC, Impulses };
+    
+    struct SignalInfo
+    {
+        Signal signal;
+        const char* name;
+    };
+    
+    const SignalInfo signals[] = {
+        { Signal::Sine, "sine1k" },
+        { Signal::QuietSine, "sine100-quiet" },
+        { Signal::Sweep, "sweep" },
+        { Signal::DrumLoop, "drums" },
+        { Signal::Silence, "silence" },
+        { Signal::DC, "dc" },
+        { Signal::Impulses, "impulses" }
+    };
+    
+    juce::AudioBuffer<float> createSignal(Signal signal)
+    {
+        const double pi = juce::MathConstants<double>::pi;
+        juce::AudioBuffer<float> buffer(NUM_CHANNELS, CASE_LENGTH);
+        buffer.clear();
+        
+        if (signal == Signal::DrumLoop)
+        {
+            UniversalCompressorTools::fillProgramMaterial(buffer, SAMPLE_RATE);
+            return buffer;
+        }
+        
+        auto* left = buffer.getWritePointer(0);
+        for (int i = 0; i < CASE_LENGTH; ++i)
+        {
+            const double t = i / SAMPLE_RATE;
+            switch (signal)
+            {
+                case Signal::Sine:
+                    left[i] = static_cast<float>(0.5 * std::sin(2.0 * pi * 1000.0 * t));
+                    break;
+                case Signal::QuietSine:
+                    left[i] = static_cast<float>(0.05 * std::sin(2.0 * pi * 100.0 * t));
+                    break;
+                case Signal::Sweep:
+                {
+                    // Exponential sweep from 20 Hz to 20 kHz over the case
+                    const double duration = CASE_LENGTH / SAMPLE_RATE;
+                    const double rate = std::log(1000.0) / duration;
+                    left[i] = static_cast<float>(0.5 * std::sin(2.0 * pi * 20.0 * (std::exp(rate * t) - 1.0) / rate));
+                    break;
+                }
+                case Signal::DC:
+                    left[i] = 0.5f;
+                    break;
+                case Signal::Impulses:
+                    left[i] = (i % (CASE_LENGTH / 4)) == 0 ? 1.0f : 0.0f;
+                    break;
+                case Signal::Silence:
+                case Signal::DrumLoop:
+                    break;
+            }
+        }
+        
+        for (int i = 0; i < CASE_LENGTH; ++i)
+            buffer.setSample(1, i, 0.5f * left[i]);
+        return buffer;
+    }
+    
+    //==============================================================================
+    struct GoldenCase
+    {
+        juce::String name;
+        int mode = 0;
+        Signal signal = Signal::Sine;
+        std::vector<std::pair<juce::String, float>> parameters;
+        bool useDouble = false;
+    };
+    
+    using ParameterList = std::vector<std::pair<juce::String, float>>;
+    
+    // A gentle and an extreme setting for every mode
+    std::vector<std::pair<const char*, ParameterList>> getModeCorners(int mode)
+    {
+        switch (mode)
+        {
+            case 0: return {
+                { "gentle",  { { "opto_peak_reduction", 40.0f }, { "opto_gain", 55.0f } } },
+                { "extreme", { { "opto_peak_reduction", 100.0f }, { "opto_gain", 70.0f }, { "opto_limit", 1.0f } } } };
+            case 1: return {
+                { "gentle",  { { "fet_input", 10.0f }, { "fet_attack", 0.8f }, { "fet_release", 1100.0f }, { "fet_ratio", 0.0f } } },
+                { "extreme", { { "fet_input", 40.0f }, { "fet_output", -10.0f }, { "fet_attack", 0.02f }, { "fet_release", 50.0f }, { "fet_ratio", 4.0f } } } };
+            case 2: return {
+                { "gentle",  { { "vca_threshold", -12.0f }, { "vca_ratio", 2.0f }, { "vca_attack", 50.0f }, { "vca_release", 5000.0f } } },
+                { "extreme", { { "vca_threshold", -38.0f }, { "vca_ratio", 120.0f }, { "vca_attack", 0.1f }, { "vca_release", 10.0f }, { "vca_overeasy", 1.0f } } } };
+            default: return {
+                { "gentle",  { { "bus_threshold", -10.0f }, { "bus_ratio", 0.0f }, { "bus_attack", 5.0f }, { "bus_release", 3.0f } } },
+                { "extreme", { { "bus_threshold", -30.0f }, { "bus_ratio", 2.0f }, { "bus_attack", 0.0f }, { "bus_release", 4.0f }, { "bus_makeup", 10.0f } } } };
+        }
+    }
+    
+    std::vector<GoldenCase> createCases()
+    {
+        // Processor-wide settings, each run on the drum loop with the gentle corner
+        const std::vector<std::pair<const char*, ParameterList>> globalVariants = {
+            { "unlinked",     { { "stereo_link", 0.0f } } },
+            { "parallel",     { { "mix", 50.0f } } },
+            { "lookahead",    { { "lookahead", 5.0f } } },
+            { "oversample1x", { { "oversampling", 0.0f } } },
+            { "oversample4x", { { "oversampling", 2.0f } } },
+            { "multiband",    { { "multiband", 2.0f } } }
+        };
+        
+        std::vector<GoldenCase> cases;
+        for (int mode = 0; mode < 4; ++mode)
+        {
+            const auto corners = getModeCorners(mode);
+            for (const auto& corner : corners)
+            {
+                for (const auto& signal : signals)
+                {
+                    GoldenCase goldenCase;
+                    goldenCase.name = juce::String(modeNames[mode]) + "-" + corner.first + "-" + signal.name;
+                    goldenCase.mode = mode;
+                    goldenCase.signal = signal.signal;
+                    goldenCase.parameters = corner.second;
+                    cases.push_back(goldenCase);
+                }
+            }
+            
+            for (const auto& variant : globalVariants)
+            {
+                GoldenCase goldenCase;
+                goldenCase.name = juce::String(modeNames[mode]) + "-" + variant.first + "-drums";
+                goldenCase.mode = mode;
+                goldenCase.signal = Signal::DrumLoop;
+                goldenCase.parameters = corners.front().second;
+                goldenCase.parameters.insert(goldenCase.parameters.end(), variant.second.begin(), variant.second.end());
+                cases.push_back(goldenCase);
+            }
+            
+            GoldenCase doubleCase;
+            doubleCase.name = juce::String(modeNames[mode]) + "-double-drums";
+            doubleCase.mode = mode;
+            doubleCase.signal = Signal::DrumLoop;
+            doubleCase.parameters = corners.front().second;
+            doubleCase.useDouble = true;
+            cases.push_back(doubleCase);
+        }
+        return cases;
+    }
+    
+    //==============================================================================
+    // Output audio plus the gain reduction meter after every block
+    struct Rendering
+    {
+        juce::AudioBuffer<float> audio;
+        std::vector<float> gainReduction;
+    };
+    
+    template <typename SampleType>
+    Rendering renderCase(const GoldenCase& goldenCase, const juce::AudioBuffer<float>& input)
+    {
+        UniversalCompressor processor;
+        UniversalCompressorTools::setParameter(processor, "mode", static_cast<float>(goldenCase.mode));
+        for (const auto& parameter : goldenCase.parameters)
+        {
+            const bool found = UniversalCompressorTools::setParameter(processor, parameter.first, parameter.second);
+            jassert(found);  // Every ID in the case tables must exist
+            juce::ignoreUnused(found);
+        }
+        
+        processor.setProcessingPrecision(std::is_same<SampleType, double>::value ? juce::AudioProcessor::doublePrecision
+                                                                                  : juce::AudioProcessor::singlePrecision);
+        processor.setRateAndBufferSizeDetails(SAMPLE_RATE, BLOCK_SIZE);
+        processor.prepareToPlay(SAMPLE_RATE, BLOCK_SIZE);
+        
+        Rendering rendering;
+        rendering.audio.setSize(NUM_CHANNELS, CASE_LENGTH);
+        juce::AudioBuffer<SampleType> block(NUM_CHANNELS, BLOCK_SIZE);
+        juce::MidiBuffer midi;
+        
+        for (int start = 0; start < CASE_LENGTH; start += BLOCK_SIZE)
+        {
+            const int numSamples = juce::jmin(BLOCK_SIZE, CASE_LENGTH - start);
+            block.setSize(NUM_CHANNELS, numSamples, false, false, true);
+            for (int channel = 0; channel < NUM_CHANNELS; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    block.setSample(channel, i, static_cast<SampleType>(input.getSample(channel, start + i)));
+            
+            processor.processBlock(block, midi);
+            
+            for (int channel = 0; channel < NUM_CHANNELS; ++channel)
+                for (int i = 0; i < numSamples; ++i)
+                    rendering.audio.setSample(channel, start + i, static_cast<float>(block.getSample(channel, i)));
+            rendering.gainReduction.push_back(processor.getGainReduction());
+        }
+        
+        processor.releaseResources();
+        return rendering;
+    }
+    
+    //==============================================================================
+    // Golden files are gzipped: magic, channel, sample and frame counts, then the
+    // audio channel by channel and the gain reduction frames, all little-endian
+    bool writeGolden(const juce::File& file, const Rendering& rendering)
+    {
+        file.deleteFile();
+        juce::FileOutputStream fileStream(file);
+        if (!fileStream.openedOk())
+            return false;
+        
+        juce::GZIPCompressorOutputStream stream(fileStream, 9);
+        stream.writeInt(GOLDEN_MAGIC);
+        stream.writeInt(rendering.audio.getNumChannels());
+        stream.writeInt(rendering.audio.getNumSamples());
+        stream.writeInt(static_cast<int>(rendering.gainReduction.size()));
+        for (int channel = 0; channel < rendering.audio.getNumChannels(); ++channel)
+            for (int i = 0; i < rendering.audio.getNumSamples(); ++i)
+                stream.writeFloat(rendering.audio.getSample(channel, i));
+        for (const float reduction : rendering.gainReduction)
+            stream.writeFloat(reduction);
+        stream.flush();
+        return true;
+    }
+    
+    bool readGolden(const juce::File& file, Rendering& rendering)
+    {
+        juce::FileInputStream fileStream(file);
+        if (!fileStream.openedOk())
+            return false;
+        
+        juce::GZIPDecompressorInputStream stream(fileStream);
+        if (stream.readInt() != GOLDEN_MAGIC)
+            return false;
+        
+        const int numChannels = stream.readInt();
+        const int numSamples = stream.readInt();
+        const int numFrames = stream.readInt();
+        if (numChannels <= 0 || numSamples <= 0 || numFrames < 0)
+            return false;
+        
+        rendering.audio.setSize(numChannels, numSamples);
+        for (int channel = 0; channel < numChannels; ++channel)
+            for (int i = 0; i < numSamples; ++i)
+                rendering.audio.setSample(channel, i, stream.readFloat());
+        rendering.gainReduction.resize(static_cast<size_t>(numFrames));
+        for (auto& reduction : rendering.gainReduction)
+            reduction = stream.readFloat();
+        
+        // A truncated file stops advancing the position
+        const juce::int64 expectedBytes = 16 + 4 * (static_cast<juce::int64>(numChannels) * numSamples + numFrames);
+        return stream.getPosition() == expectedBytes;
+    }
+    
+    //==============================================================================
+    struct Deviation
+    {
+        float maxErrorDb = -200.0f;
+        float rmsErrorDb = -200.0f;
+        float gainReductionDb = 0.0f;
+    };
+    
+    Deviation compare(const Rendering& rendering, const Rendering& golden)
+    {
+        double maxError = 0.0, sumSquares = 0.0;
+        const int numChannels = rendering.audio.getNumChannels();
+        const int numSamples = rendering.audio.getNumSamples();
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const double error = static_cast<double>(rendering.audio.getSample(channel, i)) - golden.audio.getSample(channel, i);
+                maxError = juce::jmax(maxError, std::abs(error));
+                sumSquares += error * error;
+            }
+        }
+        
+        Deviation deviation;
+        deviation.maxErrorDb = static_cast<float>(juce::Decibels::gainToDecibels(maxError, -200.0));
+        deviation.rmsErrorDb = static_cast<float>(juce::Decibels::gainToDecibels(std::sqrt(sumSquares / juce::jmax(1, numChannels * numSamples)), -200.0));
+        for (size_t frame = 0; frame < rendering.gainReduction.size(); ++frame)
+            deviation.gainReductionDb = juce::jmax(deviation.gainReductionDb, std::abs(rendering.gainReduction[frame] - golden.gainReduction[frame]));
+        return deviation;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Needed by the parameter tree's timers
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    
+    juce::ArgumentList args(argc, argv);
+    const bool update = args.removeOptionIfFound("--update");
+    const auto goldenOption = args.removeValueForOption("--golden-dir");
+    const auto filter = args.removeValueForOption("--filter");
+    const auto reportFile = args.removeValueForOption("--report");
+    
+    if (args.size() > 0)
+    {
+        std::cerr << "Unknown argument " << args.arguments.getFirst().text << std::endl;
+        return 1;
+    }
+    
+    const auto goldenDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(goldenOption.isNotEmpty() ? goldenOption : "golden");
+    if (update)
+    {
+        if (goldenDirectory.createDirectory().failed())
+        {
+            std::cerr << "Cannot create " << goldenDirectory.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else if (!goldenDirectory.isDirectory())
+    {
+        std::cout << "No goldens in " << goldenDirectory.getFullPathName() << " - record them with --update" << std::endl;
+        return EXIT_SKIPPED;
+    }
+    
+    int numFailed = 0, numRun = 0;
+    juce::Array<juce::var> report;
+    
+    for (const auto& goldenCase : createCases())
+    {
+        if (filter.isNotEmpty() && !goldenCase.name.containsIgnoreCase(filter))
+            continue;
+        
+        const auto input = createSignal(goldenCase.signal);
+        const auto rendering = goldenCase.useDouble ? renderCase<double>(goldenCase, input) : renderCase<float>(goldenCase, input);
+        const auto file = goldenDirectory.getChildFile(goldenCase.name + ".golden");
+        ++numRun;
+        
+        if (update)
+        {
+            if (!writeGolden(file, rendering))
+            {
+                std::cerr << "Cannot write " << file.getFullPathName() << std::endl;
+                return 1;
+            }
+            continue;
+        }
+        
+        Rendering golden;
+        if (!readGolden(file, golden)
+            || golden.audio.getNumChannels() != rendering.audio.getNumChannels()
+            || golden.audio.getNumSamples() != rendering.audio.getNumSamples()
+            || golden.gainReduction.size() != rendering.gainReduction.size())
+        {
+            std::cout << "FAIL " << goldenCase.name << ": missing or mismatched golden" << std::endl;
+            ++numFailed;
+            continue;
+        }
+        
+        const auto deviation = compare(rendering, golden);
+        const auto& tolerance = tolerances[goldenCase.mode];
+        const bool passed = deviation.maxErrorDb <= tolerance.maxErrorDb
+                         && deviation.rmsErrorDb <= tolerance.rmsErrorDb
+                         && deviation.gainReductionDb <= tolerance.gainReductionDb;
+        if (!passed)
+            ++numFailed;
+        
+        std::cout << (passed ? "ok   " : "FAIL ") << goldenCase.name
+                  << ": max " << juce::String(deviation.maxErrorDb, 1) << " dBFS"
+                  << ", rms " << juce::String(deviation.rmsErrorDb, 1) << " dBFS"
+                  << ", gain reduction " << juce::String(deviation.gainReductionDb, 3) << " dB" << std::endl;
+        
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("case", goldenCase.name);
+        entry->setProperty("mode", modeNames[goldenCase.mode]);
+        entry->setProperty("passed", passed);
+        entry->setProperty("maxErrorDb", deviation.maxErrorDb);
+        entry->setProperty("rmsErrorDb", deviation.rmsErrorDb);
+        entry->setProperty("gainReductionDeviationDb", deviation.gainReductionDb);
+        report.add(juce::var(entry));
+    }
+    
+    if (update)
+    {
+        std::cout << "Recorded " << numRun << " goldens in " << goldenDirectory.getFullPathName() << std::endl;
+        return 0;
+    }
+    
+    if (reportFile.isNotEmpty())
+        juce::File::getCurrentWorkingDirectory().getChildFile(reportFile).replaceWithText(juce::JSON::toString(report));
+    
+    std::cout << (numRun - numFailed) << " of " << numRun << " cases inside tolerance" << std::endl;
+    return numFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,201 @@
+/*
+  UniversalCompressorRealtimeTest
+  Real-time safety test - runs processBlock under RealtimeSafetyCheck for every mode,
+  precision and a range of layouts and sample rates while automating every parameter,
+  and fails with the offending call stacks if the callback allocates, locks or makes a
+  blocking system call.
+  
+  UniversalCompressorRealtimeTest [options]
+    --blocks <n>          Blocks processed per run (default: 400)
+    --seed <n>            Seed for the automation and block sizes (default: 1)
+*/
+
+#include "UniversalCompressorTools.h"
+#include "RealtimeSafetyCheck.h"
+#include <iostream>
+#include <memory>
+#include <type_traits>
+
+namespace
+{
+    constexpr int MAX_BLOCK_SIZE = 512;
+    constexpr int STRUCTURAL_CHANGE_INTERVAL = 64;   // Blocks between changes that re-prepare the engines
+    
+    const char* const modeNames[] = { "Opto", "FET", "VCA", "Bus" };
+    
+    // Block sizes a host may hand over, up to the prepared maximum
+    const int blockSizes[] = { 1, 7, 64, 100, 511, MAX_BLOCK_SIZE };
+    
+    struct Run
+    {
+        int mode = 0;
+        int numChannels = 2;
+        bool withSidechain = false;
+        double sampleRate = 48000.0;
+    };
+    
+    // Automatable parameters move every few blocks, as host automation does. The ones
+    // that rebuild the engines (oversampling, multiband, lookahead) change less often
+    void automate(UniversalCompressor& processor, juce::Random& random, bool includeStructural)
+    {
+        // UniversalCompressor::getParameters() is the value tree, so ask the base class
+        for (auto* parameter : static_cast<juce::AudioProcessor&>(processor).getParameters())
+        {
+            if (parameter->getCategory() != juce::AudioProcessorParameter::genericParameter)
+                continue;  // The gain reduction meter is output only
+            
+            const bool structural = !parameter->isAutomatable();
+            if (structural != includeStructural || random.nextFloat() > 0.3f)
+                continue;
+            
+            // The mode is switched by the caller
+            if (auto* withID = dynamic_cast<juce::AudioProcessorParameterWithID*>(parameter))
+                if (withID->paramID == "mode")
+                    continue;
+            
+            parameter->setValueNotifyingHost(random.nextFloat());
+        }
+    }
+    
+    // Processes the run's blocks and returns the violations seen, empty when clean
+    template <typename SampleType>
+    juce::String runCheck(const Run& run, int numBlocks, juce::Random& random)
+    {
+        UniversalCompressor processor;
+        auto buses = processor.getBusesLayout();
+        buses.inputBuses.getReference(0) = UniversalCompressorTools::getLayoutForChannels(run.numChannels);
+        buses.outputBuses.getReference(0) = buses.inputBuses[0];
+        if (buses.inputBuses.size() > 1)
+            buses.inputBuses.getReference(1) = run.withSidechain ? juce::AudioChannelSet::stereo() : juce::AudioChannelSet::disabled();
+        if (!processor.setBusesLayout(buses))
+            return "layout rejected";
+        
+        UniversalCompressorTools::setParameter(processor, "mode", static_cast<float>(run.mode));
+        processor.setProcessingPrecision(std::is_same<SampleType, double>::value ? juce::AudioProcessor::doublePrecision
+                                                                                  : juce::AudioProcessor::singlePrecision);
+        processor.setRateAndBufferSizeDetails(run.sampleRate, MAX_BLOCK_SIZE);
+        processor.prepareToPlay(run.sampleRate, MAX_BLOCK_SIZE);
+        
+        const int numBufferChannels = juce::jmax(processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+        juce::AudioBuffer<SampleType> material(numBufferChannels, MAX_BLOCK_SIZE * 16);
+        UniversalCompressorTools::fillProgramMaterial(material, run.sampleRate);
+        
+        juce::AudioBuffer<SampleType> buffer(numBufferChannels, MAX_BLOCK_SIZE);
+        juce::MidiBuffer midi;
+        RealtimeSafetyCheck::reset();
+        
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            automate(processor, random, false);
+            if (block > 0 && block % STRUCTURAL_CHANGE_INTERVAL == 0)
+            {
+                // Hosts may send these inside the callback - the VST3 wrapper applies parameter
+                // changes in process() - so the engines must not be rebuilt there. JUCE's own
+                // listener notification and message posting lock, so only the heap is checked
+                {
+                    RealtimeSafetyCheck::ScopedAudioCallback hostCallback(RealtimeSafetyCheck::heap);
+                    automate(processor, random, true);
+                }
+                
+                // The message thread then rebuilds the engines between callbacks
+                juce::MessageManager::getInstance()->runDispatchLoopUntil(1);
+            }
+            
+            // Mostly the mode under test, with the odd block switched to another one
+            const int mode = random.nextFloat() < 0.1f ? random.nextInt(4) : run.mode;
+            UniversalCompressorTools::setParameter(processor, "mode", static_cast<float>(mode));
+            
+            // Resizing within the allocated size, as hosts do, before the callback starts
+            const int numSamples = blockSizes[random.nextInt(juce::numElementsInArray(blockSizes))];
+            const int start = (block * MAX_BLOCK_SIZE) % (material.getNumSamples() - MAX_BLOCK_SIZE);
+            buffer.setSize(numBufferChannels, numSamples, false, false, true);
+            for (int channel = 0; channel < numBufferChannels; ++channel)
+                buffer.copyFrom(channel, 0, material, channel, start, numSamples);
+            
+            processor.processBlock(buffer, midi);
+        }
+        
+        processor.releaseResources();
+        
+        juce::String violations;
+        if (RealtimeSafetyCheck::getNumViolations() > 0)
+            violations = RealtimeSafetyCheck::describeViolations();
+        RealtimeSafetyCheck::reset();
+        return violations;
+    }
+    
+    // Makes sure the check is live in this build, so a clean result means something
+    bool checkIsActive()
+    {
+        RealtimeSafetyCheck::reset();
+        {
+            RealtimeSafetyCheck::ScopedAudioCallback audioCallback;
+            auto allocation = std::make_unique<char[]>(64);
+        }
+        const bool detected = RealtimeSafetyCheck::getNumViolations() > 0;
+        RealtimeSafetyCheck::reset();
+        return detected;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // Needed by the parameter tree's timers and to deliver the processor's rebuilds
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    
+    juce::ArgumentList args(argc, argv);
+    const auto blocksOption = args.removeValueForOption("--blocks");
+    const auto seedOption = args.removeValueForOption("--seed");
+    const int numBlocks = blocksOption.isNotEmpty() ? juce::jmax(1, blocksOption.getIntValue()) : 400;
+    juce::Random random(seedOption.isNotEmpty() ? seedOption.getLargeIntValue() : 1);
+    
+    if (args.size() > 0)
+    {
+        std::cerr << "Unknown argument " << args.arguments.getFirst().text << std::endl;
+        return 1;
+    }
+    
+    if (!checkIsActive())
+    {
+        std::cerr << "The real-time safety check is not active - build with UNIVERSAL_COMPRESSOR_RT_SAFETY_CHECK=1" << std::endl;
+        return 1;
+    }
+    
+    const Run layouts[] = {
+        { 0, 1, false, 44100.0 },
+        { 0, 2, true,  48000.0 },
+        { 0, 2, false, 96000.0 },
+        { 0, 6, false, 48000.0 }
+    };
+    
+    int numFailed = 0, numRuns = 0;
+    for (int precision = 0; precision < 2; ++precision)
+    {
+        for (int mode = 0; mode < 4; ++mode)
+        {
+            for (auto run : layouts)
+            {
+                run.mode = mode;
+                const auto violations = precision == 1 ? runCheck<double>(run, numBlocks, random)
+                                                       : runCheck<float>(run, numBlocks, random);
+                ++numRuns;
+                
+                const juce::String name = juce::String(modeNames[mode]) + " " + (precision == 1 ? "double" : "float")
+                                        + " " + juce::String(run.numChannels) + " ch" + (run.withSidechain ? " + sidechain" : "")
+                                        + " " + juce::String(run.sampleRate / 1000.0, 1) + " kHz";
+                if (violations.isEmpty())
+                {
+                    std::cout << "ok   " << name << std::endl;
+                }
+                else
+                {
+                    std::cout << "FAIL " << name << ": " << violations << std::endl;
+                    ++numFailed;
+                }
+            }
+        }
+    }
+    
+    std::cout << (numRuns - numFailed) << " of " << numRuns << " runs real-time safe" << std::endl;
+    return numFailed == 0 ? 0 : 1;
+}
@@ -0,0 +1,316 @@
+/*
+  UniversalCompressorRender
+  Headless batch renderer - runs the compressor over audio files without a DAW.
+  
+  UniversalCompressorRender [options] <input files...>
+    --state <file>        Plugin state saved by getStateInformation
+    --params <file>       JSON object of parameter IDs to values, applied after --state
+    --output-dir <dir>    Where rendered files go (default: next to each input)
+    --suffix <text>       Appended to each output name (default: _compressed)
+    --threads <n>         Files rendered at once (default: one per CPU core)
+    --block-size <n>      Samples per processBlock call (default: 1024)
+    --stage-profile <file>  Time per stage and mode over all files as CSV, or JSON for a
+                          .json file. Needs a build with UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+*/
+
+#include "UniversalCompressorTools.h"
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <iostream>
+
+namespace
+{
+    constexpr int DEFAULT_BLOCK_SIZE = 1024;
+    constexpr juce::int64 MEMORY_MAP_MIN_BYTES = 16 * 1024 * 1024;  // Smaller files are read as a stream
+    
+    struct RenderSettings
+    {
+        juce::MemoryBlock state;        // Processor state every file starts from
+        juce::File outputDirectory;     // Empty = next to the input
+        juce::String suffix = "_compressed";
+        int blockSize = DEFAULT_BLOCK_SIZE;
+    };
+    
+    // Console output is shared by the render threads
+    juce::CriticalSection consoleLock;
+    
+    void printLine(const juce::String& text, bool isError = false)
+    {
+        const juce::ScopedLock lock(consoleLock);
+        (isError ? std::cerr : std::cout) << text << std::endl;
+    }
+    
+    #if UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+    // Stage timings summed over every rendered file, for --stage-profile
+    juce::CriticalSection stageProfileLock;
+    UniversalCompressor::StageTimings profiledStages{};
+    #endif
+    
+    // Applies a JSON object of parameter ID to value. Numbers are plain parameter
+    // values (dB, ms, choice index), strings go through the parameter's own text parser
+    juce::Result applyParameterFile(UniversalCompressor& processor, const juce::File& file)
+    {
+        juce::var json;
+        const auto parsed = juce::JSON::parse(file.loadFileAsString(), json);
+        if (parsed.failed())
+            return juce::Result::fail(file.getFullPathName() + ": " + parsed.getErrorMessage());
+        
+        const auto* object = json.getDynamicObject();
+        if (object == nullptr)
+            return juce::Result::fail(file.getFullPathName() + ": expected an object of parameter IDs");
+        
+        for (const auto& property : object->getProperties())
+        {
+            auto* parameter = processor.getParameters().getParameter(property.name.toString());
+            if (parameter == nullptr)
+                return juce::Result::fail(file.getFullPathName() + ": unknown parameter " + property.name.toString());
+            
+            if (property.value.isString())
+                parameter->setValueNotifyingHost(parameter->getValueForText(property.value.toString()));
+            else
+                parameter->setValueNotifyingHost(parameter->convertTo0to1(static_cast<float>(property.value)));
+        }
+        return juce::Result::ok();
+    }
+    
+    // Large WAV and AIFF files are mapped into memory rather than streamed
+    std::unique_ptr<juce::AudioFormatReader> createReader(juce::AudioFormatManager& formatManager, const juce::File& file)
+    {
+        if (file.getSize() >= MEMORY_MAP_MIN_BYTES)
+        {
+            if (auto* format = formatManager.findFormatForFileExtension(file.getFileExtension()))
+            {
+                std::unique_ptr<juce::MemoryMappedAudioFormatReader> mapped(format->createMemoryMappedReader(file));
+                if (mapped != nullptr && mapped->mapEntireFile())
+                    return mapped;
+            }
+        }
+        return std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(file));
+    }
+    
+    juce::Result renderFile(const juce::File& input, const RenderSettings& settings)
+    {
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        
+        auto reader = createReader(formatManager, input);
+        if (reader == nullptr)
+            return juce::Result::fail("unreadable audio file");
+        
+        const int numChannels = static_cast<int>(reader->numChannels);
+        const double sampleRate = reader->sampleRate;
+        const juce::int64 length = reader->lengthInSamples;
+        
+        // The compressor, configured for this file's channels and rendering offline
+        UniversalCompressor processor;
+        processor.setStateInformation(settings.state.getData(), static_cast<int>(settings.state.getSize()));
+        
+        if (!UniversalCompressorTools::setMainLayout(processor, numChannels))
+            return juce::Result::fail("unsupported channel count " + juce::String(numChannels));
+        
+        processor.setNonRealtime(true);
+        processor.setRateAndBufferSizeDetails(sampleRate, settings.blockSize);
+        processor.prepareToPlay(sampleRate, settings.blockSize);
+        
+        // Output keeps the input's format and, where the format allows it, its bit depth
+        auto* format = formatManager.findFormatForFileExtension(input.getFileExtension());
+        if (format == nullptr)
+            return juce::Result::fail("no writer for " + input.getFileExtension());
+        
+        const auto bitDepths = format->getPossibleBitDepths();
+        const int bitDepth = bitDepths.contains(static_cast<int>(reader->bitsPerSample)) ? static_cast<int>(reader->bitsPerSample)
+                                                                                          : bitDepths.getLast();
+        
+        const auto directory = settings.outputDirectory == juce::File() ? input.getParentDirectory() : settings.outputDirectory;
+        const auto output = directory.getChildFile(input.getFileNameWithoutExtension() + settings.suffix + input.getFileExtension());
+        output.deleteFile();
+        
+        auto stream = output.createOutputStream();
+        if (stream == nullptr)
+            return juce::Result::fail("cannot write " + output.getFullPathName());
+        
+        std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), sampleRate,
+                                                                                 static_cast<unsigned int>(numChannels),
+                                                                                 bitDepth, reader->metadataValues, 0));
+        if (writer == nullptr)
+            return juce::Result::fail("cannot write " + output.getFullPathName());
+        stream.release();  // Owned by the writer now
+        
+        // The output is shifted back by the reported latency, so the file keeps its
+        // length and lines up with the input. Silence is fed past the end to flush it
+        const juce::int64 latency = processor.getLatencySamples();
+        juce::AudioBuffer<float> buffer(numChannels, settings.blockSize);
+        juce::MidiBuffer midi;
+        
+        for (juce::int64 position = 0; position < length + latency; position += settings.blockSize)
+        {
+            const int numSamples = static_cast<int>(juce::jmin(static_cast<juce::int64>(settings.blockSize), length + latency - position));
+            buffer.setSize(numChannels, numSamples, false, false, true);
+            buffer.clear();
+            
+            if (position < length)
+            {
+                const int numToRead = static_cast<int>(juce::jmin(static_cast<juce::int64>(numSamples), length - position));
+                reader->read(&buffer, 0, numToRead, position, true, true);
+            }
+            
+            processor.processBlock(buffer, midi);
+            
+            const int skip = static_cast<int>(juce::jlimit(static_cast<juce::int64>(0), static_cast<juce::int64>(numSamples), latency - position));
+            if (skip < numSamples && !writer->writeFromAudioSampleBuffer(buffer, skip, numSamples - skip))
+                return juce::Result::fail("write error in " + output.getFullPathName());
+        }
+        
+        processor.releaseResources();
+        
+        #if UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+        {
+            const juce::ScopedLock lock(stageProfileLock);
+            UniversalCompressorTools::addStageTimings(profiledStages, processor.getStageTimings());
+        }
+        #endif
+        
+        printLine(input.getFullPathName() + " -> " + output.getFullPathName());
+        return juce::Result::ok();
+    }
+    
+    void printUsage()
+    {
+        printLine("Usage: UniversalCompressorRender [options] <input files...>\n"
+                  "  --state <file>        Plugin state saved by the plugin (getStateInformation)\n"
+                  "  --params <file>       JSON object of parameter IDs to values, applied after --state\n"
+                  "  --output-dir <dir>    Where rendered files go (default: next to each input)\n"
+                  "  --suffix <text>       Appended to each output name (default: _compressed)\n"
+                  "  --threads <n>         Files rendered at once (default: one per CPU core)\n"
+                  "  --block-size <n>      Samples per processBlock call (default: "
+                  + juce::String(DEFAULT_BLOCK_SIZE) + ")\n"
+                  "  --stage-profile <file>  Time per stage and mode as CSV, or JSON for a .json file\n"
+                  "                        (builds with UNIVERSAL_COMPRESSOR_STAGE_TIMERS)");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // The parameter tree needs a message manager, even though nothing is dispatched
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    
+    juce::ArgumentList args(argc, argv);
+    if (args.size() == 0 || args.removeOptionIfFound("--help|-h"))
+    {
+        printUsage();
+        return args.size() == 0 ? 1 : 0;
+    }
+    
+    const auto stateFile = args.removeValueForOption("--state");
+    const auto paramsFile = args.removeValueForOption("--params");
+    const auto outputDirectory = args.removeValueForOption("--output-dir");
+    const auto suffix = args.removeValueForOption("--suffix");
+    const auto threads = args.removeValueForOption("--threads|-j");
+    const auto blockSize = args.removeValueForOption("--block-size");
+    const auto stageProfileFile = args.removeValueForOption("--stage-profile");
+    
+    #if ! UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+    if (stageProfileFile.isNotEmpty())
+    {
+        printLine("--stage-profile needs a build with UNIVERSAL_COMPRESSOR_STAGE_TIMERS=ON", true);
+        return 1;
+    }
+    #endif
+    
+    RenderSettings settings;
+    if (suffix.isNotEmpty())
+        settings.suffix = suffix;
+    if (blockSize.isNotEmpty())
+        settings.blockSize = juce::jlimit(16, 65536, blockSize.getIntValue());
+    if (outputDirectory.isNotEmpty())
+    {
+        settings.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(outputDirectory);
+        if (settings.outputDirectory.createDirectory().failed())
+        {
+            printLine("Cannot create " + settings.outputDirectory.getFullPathName(), true);
+            return 1;
+        }
+    }
+    
+    // Resolve the state and parameter file once into a single state blob that every
+    // render starts from, so bad input fails before any file is touched
+    {
+        UniversalCompressor processor;
+        if (stateFile.isNotEmpty())
+        {
+            juce::MemoryBlock state;
+            const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(stateFile);
+            if (!file.loadFileAsData(state))
+            {
+                printLine("Cannot read " + file.getFullPathName(), true);
+                return 1;
+            }
+            processor.setStateInformation(state.getData(), static_cast<int>(state.getSize()));
+        }
+        
+        if (paramsFile.isNotEmpty())
+        {
+            const auto result = applyParameterFile(processor, juce::File::getCurrentWorkingDirectory().getChildFile(paramsFile));
+            if (result.failed())
+            {
+                printLine(result.getErrorMessage(), true);
+                return 1;
+            }
+        }
+        
+        processor.getStateInformation(settings.state);
+    }
+    
+    juce::Array<juce::File> inputs;
+    for (const auto& argument : args.arguments)
+    {
+        if (argument.isOption())
+        {
+            printLine("Unknown option " + argument.text, true);
+            return 1;
+        }
+        inputs.add(argument.resolveAsFile());
+    }
+    
+    if (inputs.isEmpty())
+    {
+        printUsage();
+        return 1;
+    }
+    
+    // One processor per file, rendered in parallel
+    const int numThreads = threads.isNotEmpty() ? juce::jmax(1, threads.getIntValue()) : juce::SystemStats::getNumCpus();
+    std::atomic<int> failures{0};
+    {
+        juce::ThreadPool pool(juce::jmin(numThreads, inputs.size()));
+        for (const auto& input : inputs)
+        {
+            pool.addJob([input, &settings, &failures]
+            {
+                const auto result = renderFile(input, settings);
+                if (result.failed())
+                {
+                    printLine(input.getFullPathName() + ": " + result.getErrorMessage(), true);
+                    ++failures;
+                }
+                return juce::ThreadPoolJob::jobHasFinished;
+            });
+        }
+        
+        while (pool.getNumJobs() > 0)
+            juce::Thread::sleep(20);
+    }
+    
+    #if UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+    if (stageProfileFile.isNotEmpty())
+    {
+        const auto file = juce::File::getCurrentWorkingDirectory().getChildFile(stageProfileFile);
+        if (!UniversalCompressorTools::writeStageProfile(profiledStages, file))
+        {
+            printLine("Cannot write " + file.getFullPathName(), true);
+            return 1;
+        }
+    }
+    #endif
+    
+    return failures.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+/*
+  UniversalCompressorTools.h
+  Helpers shared by the command-line tools (renderer, benchmark)
+*/
+
+#pragma once
+
+#include "UniversalCompressor.h"
+
+namespace UniversalCompressorTools
+{
+    // Bus layout the compressor runs numChannels channels in, disabled for counts
+    // without a supported layout
+    inline juce::AudioChannelSet getLayoutForChannels(int numChannels)
+    {
+        switch (numChannels)
+        {
+            case 1:  return juce::AudioChannelSet::mono();
+            case 2:  return juce::AudioChannelSet::stereo();
+            case 3:  return juce::AudioChannelSet::createLCR();
+            case 5:  return juce::AudioChannelSet::create5point0();
+            case 6:  return juce::AudioChannelSet::create5point1();
+            case 7:  return juce::AudioChannelSet::create7point0();
+            case 8:  return juce::AudioChannelSet::create7point1();
+            case 10: return juce::AudioChannelSet::create5point1point4();
+            case 11: return juce::AudioChannelSet::create7point0point4();
+            case 12: return juce::AudioChannelSet::create7point1point4();
+            default: return juce::AudioChannelSet::disabled();
+        }
+    }
+    
+    // Puts the main bus into the layout for numChannels, false when there is none
+    inline bool setMainLayout(UniversalCompressor& processor, int numChannels)
+    {
+        const auto layout = getLayoutForChannels(numChannels);
+        auto buses = processor.getBusesLayout();
+        buses.inputBuses.getReference(0) = layout;
+        buses.outputBuses.getReference(0) = layout;
+        return !layout.isDisabled() && processor.setBusesLayout(buses);
+    }
+    
+    // Sets a parameter from its plain value (dB, ms, choice index)
+    inline bool setParameter(UniversalCompressor& processor, const juce::String& parameterID, float value)
+    {
+        auto* parameter = processor.getParameters().getParameter(parameterID);
+        if (parameter == nullptr)
+            return false;
+        
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+        return true;
+    }
+    
+    // Deterministic program material that keeps every mode compressing: a kick and a
+    // noise snare over a slowly pulsing bass chord, slightly different on each channel
+    template <typename SampleType>
+    void fillProgramMaterial(juce::AudioBuffer<SampleType>& buffer, double sampleRate, int seed = 1)
+    {
+        const double pi = juce::MathConstants<double>::pi;
+        const int beatLength = juce::jmax(1, static_cast<int>(sampleRate * 0.5));  // 120 bpm
+        
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+        {
+            juce::Random random(seed + channel);
+            auto* data = buffer.getWritePointer(channel);
+            const double detune = 1.0 + 0.003 * channel;
+            
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const double t = i / sampleRate;
+                const int beat = i / beatLength;
+                const double beatTime = (i % beatLength) / sampleRate;
+                
+                // Kick on every beat, snare on the off beats
+                const double kick = 0.9 * std::exp(-beatTime * 18.0) * std::sin(2.0 * pi * (50.0 + 90.0 * std::exp(-beatTime * 30.0)) * beatTime);
+                const double snare = (beat % 2 == 1) ? 0.5 * std::exp(-beatTime * 25.0) * (random.nextDouble() * 2.0 - 1.0) : 0.0;
+                
+                // Bass chord with a slow swell
+                const double swell = 0.15 + 0.1 * std::sin(2.0 * pi * 0.25 * t);
+                const double chord = swell * (std::sin(2.0 * pi * 110.0 * detune * t) + 0.5 * std::sin(2.0 * pi * 164.8 * detune * t)
+                                              + 0.3 * std::sin(2.0 * pi * 220.0 * detune * t));
+                
+                data[i] = static_cast<SampleType>(kick + snare + chord);
+            }
+        }
+    }
+    
+    #if UNIVERSAL_COMPRESSOR_STAGE_TIMERS
+    // Adds one processor's stage timings to a running total
+    inline void addStageTimings(UniversalCompressor::StageTimings& total, const UniversalCompressor::StageTimings& timings)
+    {
+        for (size_t mode = 0; mode < total.size(); ++mode)
+        {
+            for (size_t stage = 0; stage < total[mode].size(); ++stage)
+            {
+                total[mode][stage].ticks += timings[mode][stage].ticks;
+                total[mode][stage].calls += timings[mode][stage].calls;
+                total[mode][stage].samples += timings[mode][stage].samples;
+            }
+        }
+    }
+    
+    // One object per mode and stage that ran. Time per sample is over every frame the
+    // mode processed, so the stages of a mode add up to its profiled cost per sample
+    inline juce::Array<juce::var> getStageProfile(const UniversalCompressor::StageTimings& timings)
+    {
+        const char* const modeNames[] = { "Opto", "FET", "VCA", "Bus" };
+        const double secondsPerTick = 1.0 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+        
+        juce::Array<juce::var> profile;
+        for (size_t mode = 0; mode < timings.size(); ++mode)
+        {
+            juce::uint64 modeTicks = 0, modeSamples = 0;
+            for (const auto& timing : timings[mode])
+            {
+                modeTicks += timing.ticks;
+                modeSamples = juce::jmax(modeSamples, timing.samples);
+            }
+            
+            for (int stage = 0; stage < UniversalCompressor::NUM_PROFILED_STAGES; ++stage)
+            {
+                const auto& timing = timings[mode][static_cast<size_t>(stage)];
+                if (timing.calls == 0)
+                    continue;
+                
+                const double seconds = static_cast<double>(timing.ticks) * secondsPerTick;
+                auto* entry = new juce::DynamicObject();
+                entry->setProperty("mode", modeNames[mode]);
+                entry->setProperty("stage", UniversalCompressor::getStageName(static_cast<UniversalCompressor::ProfiledStage>(stage)));
+                entry->setProperty("calls", static_cast<juce::int64>(timing.calls));
+                entry->setProperty("samples", static_cast<juce::int64>(timing.samples));
+                entry->setProperty("seconds", seconds);
+                entry->setProperty("nsPerSample", modeSamples > 0 ? seconds * 1.0e9 / static_cast<double>(modeSamples) : 0.0);
+                entry->setProperty("percent", modeTicks > 0 ? 100.0 * static_cast<double>(timing.ticks) / static_cast<double>(modeTicks) : 0.0);
+                profile.add(juce::var(entry));
+            }
+        }
+        return profile;
+    }
+    
+    // Writes the profile as JSON for a .json file and as CSV otherwise
+    inline bool writeStageProfile(const UniversalCompressor::StageTimings& timings, const juce::File& file)
+    {
+        const auto profile = getStageProfile(timings);
+        if (file.hasFileExtension("json"))
+            return file.replaceWithText(juce::JSON::toString(juce::var(profile)));
+        
+        juce::String csv("mode,stage,calls,samples,seconds,ns_per_sample,percent\n");
+        for (const auto& entry : profile)
+        {
+            csv << entry["mode"].toString() << "," << entry["stage"].toString() << ","
+                << entry["calls"].toString() << "," << entry["samples"].toString() << ","
+                << juce::String(static_cast<double>(entry["seconds"]), 6) << ","
+                << juce::String(static_cast<double>(entry["nsPerSample"]), 3) << ","
+                << juce::String(static_cast<double>(entry["percent"]), 2) << "\n";
+        }
+        return file.replaceWithText(csv);
+    }
+    #endif
+}
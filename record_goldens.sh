@@ -0,0 +1,63 @@
+#!/bin/bash
+
+# Universal Compressor Golden Recording Script
+#
+# Renders golden/ from a baseline revision so the golden null test compares the
+# working tree against it. Goldens only null against builds made with the same
+# compiler, JUCE version and build type, so record them on the machine that runs
+# the test.
+#
+#   ./record_goldens.sh [baseline-ref] [juce-dir]
+#
+# The baseline defaults to HEAD, JUCE to the CMake default. An empty or all-zero
+# baseline (the first push of a branch) falls back to the merge base with main.
+# Set CMAKE_BUILD_TYPE to match the test build (Release by default).
+#
+# A baseline from before the golden test existed has nothing to record, so the
+# script says so and exits without writing golden/ - the test then reports as
+# skipped.
+set -e
+
+BASELINE=${1-HEAD}
+JUCE_DIR=${2:-/home/marc/projects/JUCE}
+BUILD_TYPE=${CMAKE_BUILD_TYPE:-Release}
+
+ROOT=$(cd "$(dirname "$0")" && pwd)
+
+# No previous head - compare against where the branch left main
+if [[ -z "${BASELINE//0/}" ]]; then
+    BASELINE=$(git -C "$ROOT" merge-base HEAD origin/main 2>/dev/null || git -C "$ROOT" merge-base HEAD main 2>/dev/null || true)
+    if [ -z "$BASELINE" ]; then
+        echo "No baseline given and no merge base with main - nothing to record"
+        exit 0
+    fi
+fi
+
+if ! git -C "$ROOT" cat-file -e "$BASELINE:UniversalCompressorGoldenTest.cpp" 2>/dev/null; then
+    echo "Baseline $BASELINE has no golden test - nothing to record, the null test will be skipped"
+    exit 0
+fi
+
+WORKTREE=$(mktemp -d)
+trap 'git -C "$ROOT" worktree remove --force "$WORKTREE"' EXIT
+
+echo "Recording goldens from $BASELINE..."
+
+# Build the test at the baseline in a separate worktree (build/ holds a local cache).
+# The baseline's sources are built with this tree's CMakeLists.txt, so older revisions
+# that hard-code the JUCE path still pick up JUCE_DIR and get the same flags as the test
+git -C "$ROOT" worktree add --detach "$WORKTREE" "$BASELINE"
+cp "$ROOT/CMakeLists.txt" "$WORKTREE/CMakeLists.txt"
+cmake -S "$WORKTREE" -B "$WORKTREE/golden_build" -DCMAKE_BUILD_TYPE="$BUILD_TYPE" -DJUCE_DIR="$JUCE_DIR" \
+      -DUNIVERSAL_COMPRESSOR_BUILD_RENDERER=OFF -DUNIVERSAL_COMPRESSOR_BUILD_BENCHMARK=OFF
+cmake --build "$WORKTREE/golden_build" --target UniversalCompressorGoldenTest -j"$(nproc)"
+
+TOOL=$(find "$WORKTREE/golden_build" -type f -name UniversalCompressorGoldenTest -perm -u+x | head -n 1)
+if [ -z "$TOOL" ]; then
+    echo "UniversalCompressorGoldenTest was not built"
+    exit 1
+fi
+
+"$TOOL" --update --golden-dir "$ROOT/golden"
+
+echo "Goldens written to $ROOT/golden"